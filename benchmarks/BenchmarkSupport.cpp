@@ -0,0 +1,50 @@
+// StockTracker.DataService/benchmarks/BenchmarkSupport.cpp
+#include "BenchmarkSupport.h"
+#include <cstdio>
+
+namespace StockTracker::Benchmarks {
+
+    namespace {
+        // The five built-in tickers
+        constexpr size_t builtin_symbols = 5;
+
+        // Fixed seed so every run benchmarks the same universe
+        MockProviderConfig universeConfig(size_t symbol_count) {
+            MockProviderConfig config;
+            config.seed = 42;
+            config.synthetic.symbols = symbol_count > builtin_symbols ? symbol_count - builtin_symbols : 0;
+            return config;
+        }
+    }
+
+    MockUniverse::MockUniverse(size_t symbol_count, size_t stream_count)
+        : provider(symbols, stream_count, universeConfig(symbol_count))
+    {
+        for (const auto& symbol : provider.getAvailableSymbols()) {
+            if (ids.size() == symbol_count) {
+                break;
+            }
+            ids.push_back(*symbols.find(symbol));
+        }
+    }
+
+    std::vector<Tick> MockUniverse::cycle() {
+        std::vector<Tick> ticks;
+        ticks.reserve(ids.size());
+        provider.generateTicks(ids.data(), ids.size(), ticks);
+        return ticks;
+    }
+
+    ScratchDatabase::ScratchDatabase(const std::string& name)
+        : file(name + ".bench.db")
+    {
+        std::remove(file.c_str());
+    }
+
+    ScratchDatabase::~ScratchDatabase() {
+        // SQLite's WAL sidecars go too
+        std::remove(file.c_str());
+        std::remove((file + "-wal").c_str());
+        std::remove((file + "-shm").c_str());
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "AllocationCounter.h"
+#include "LatencyHistogram.h"
+#include "MockData.h"
+#include "SymbolTable.h"
+#include "Tick.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace StockTracker::Benchmarks {
+
+    // Symbol counts the per-symbol benchmarks run at, from the built-in five
+    // tickers up to a 100k-symbol universe
+    inline void symbolCounts(benchmark::internal::Benchmark* b) {
+        for (int64_t symbols : { 5, 100, 1000, 10000, 100000 }) {
+            b->Arg(symbols);
+        }
+    }
+
+    // A mock provider quoting exactly `symbol_count` symbols: the built-in
+    // tickers, padded with synthetic ones
+    struct MockUniverse {
+        SymbolTable symbols;
+        MockDataProvider provider;
+        std::vector<SymbolId> ids;
+
+        explicit MockUniverse(size_t symbol_count, size_t stream_count = 1);
+
+        // One tick per symbol, as a poll cycle would produce
+        std::vector<Tick> cycle();
+    };
+
+    // Tail latency from a LatencySummary as benchmark counters (microseconds)
+    inline void reportLatency(benchmark::State& state, const LatencySummary& latency) {
+        state.counters["p50_us"] = static_cast<double>(latency.p50_ns) / 1e3;
+        state.counters["p99_us"] = static_cast<double>(latency.p99_ns) / 1e3;
+        state.counters["p999_us"] = static_cast<double>(latency.p999_ns) / 1e3;
+        state.counters["max_us"] = static_cast<double>(latency.max_ns) / 1e3;
+    }
+
+    // Checks that a path meant to be allocation-free stays that way: heap
+    // allocations on this thread from construction to check() are reported
+    // as allocs_per_item, and any at all fail the benchmark. Start it after
+    // a warm-up pass so first-use growth is not counted. The benchmark
+    // project defines STOCKTRACKER_COUNT_ALLOCATIONS; without it nothing is
+    // counted.
+    class AllocationCheck {
+    private:
+        uint64_t start{ AllocationCounter::threadAllocations() };
+
+    public:
+        void check(benchmark::State& state, int64_t items) const {
+            const uint64_t made = AllocationCounter::threadAllocations() - start;
+            state.counters["allocs_per_item"] = items > 0 ? static_cast<double>(made) / items : 0.0;
+            if (made != 0) {
+                state.SkipWithError("Steady-state path allocated on the heap");
+            }
+        }
+    };
+
+    // Fresh database file for one benchmark run, removed again on destruction
+    class ScratchDatabase {
+    private:
+        std::string file;
+
+    public:
+        explicit ScratchDatabase(const std::string& name);
+        ~ScratchDatabase();
+
+        const std::string& path() const { return file; }
+
+        ScratchDatabase(const ScratchDatabase&) = delete;
+        ScratchDatabase& operator=(const ScratchDatabase&) = delete;
+    };
+}
@@ -0,0 +1,202 @@
+// StockTracker.DataService/benchmarks/PipelineBenchmarks.cpp
+//
+// The stages that hand work to another thread or to SQLite, and the whole
+// publish path end to end at a chosen tick rate.
+#include "BenchmarkSupport.h"
+#include "BarStore.h"
+#include "MessagePublisher.h"
+#include "PriceStore.h"
+#include "PriceWriter.h"
+#include "TickJournal.h"
+#include "StockTracker/DatabaseService.h"
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+namespace StockTracker::Benchmarks {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Publisher on an ephemeral loopback port, so runs never collide
+        // with a live service or with each other
+        MessagePublisherConfig benchPublisherConfig() {
+            MessagePublisherConfig config;
+            config.endpoint = "tcp://127.0.0.1:*";
+            return config;
+        }
+
+        // Journal directory for one benchmark run, removed again afterwards
+        struct ScratchJournal {
+            TickJournalConfig config;
+
+            explicit ScratchJournal(const std::string& name) {
+                config.enabled = true;
+                config.directory = name + ".bench-journal";
+                std::filesystem::remove_all(config.directory);
+            }
+            ~ScratchJournal() {
+                std::error_code error;
+                std::filesystem::remove_all(config.directory, error);
+            }
+        };
+
+        // Wait for `count` queued quotes to leave the publisher, sent or
+        // replaced by a newer one. False if that takes longer than
+        // `timeout`, e.g. because a send threw and the quote was lost.
+        bool waitUntilSent(const MessagePublisher& publisher, uint64_t count,
+            Clock::duration timeout = std::chrono::seconds(10)) {
+            const auto deadline = Clock::now() + timeout;
+            while (true) {
+                auto stats = publisher.stats();
+                if (stats.sent + stats.conflated >= count) {
+                    return true;
+                }
+                if (Clock::now() >= deadline) {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        // Sleep until the cycle's share of `ticks_per_second` has elapsed;
+        // 0 runs unpaced
+        void pace(Clock::time_point cycle_start, size_t ticks, int64_t ticks_per_second) {
+            if (ticks_per_second > 0) {
+                std::this_thread::sleep_until(cycle_start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(static_cast<double>(ticks) / static_cast<double>(ticks_per_second))));
+            }
+        }
+    }
+
+    // One synchronous DatabaseService::savePrice() row per iteration, the
+    // cost PriceWriter takes off the tick path
+    static void BM_SavePrice(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        ScratchDatabase scratch("save_price");
+        DatabaseService db(scratch.path());
+        const auto ticks = universe.cycle();
+
+        size_t next = 0;
+        for (auto _ : state) {
+            const auto& tick = ticks[next];
+            db.savePrice(StockQuote{ universe.symbols.name(tick.symbol), tick.price, tick.timestamp });
+            next = (next + 1) % ticks.size();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SavePrice)->Arg(5)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+    // PriceWriter draining one cycle's ticks in batches
+    static void BM_PriceWriterCycle(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        ScratchDatabase scratch("price_writer");
+        DatabaseMutex db_mutex;
+        BarStore bars(scratch.path(), DatabaseTuningConfig{}, universe.symbols, db_mutex);
+        SqlitePriceStore store(scratch.path(), DatabaseTuningConfig{}, db_mutex, universe.symbols);
+        const auto ticks = universe.cycle();
+
+        PriceWriterConfig config;
+        config.overflow_policy = OverflowPolicy::Block;  // Measure throughput, not drops
+        PriceWriter writer(store, bars, config);
+
+        for (auto _ : state) {
+            for (const auto& tick : ticks) {
+                writer.enqueue(tick);
+            }
+        }
+        // Snapshot before stop(): its final flush runs outside the timed
+        // loop and must not count toward the rate
+        auto stats = writer.stats();
+        writer.stop();
+
+        state.SetItemsProcessed(static_cast<int64_t>(stats.written));
+        state.counters["batches"] = static_cast<double>(stats.batches);
+        state.counters["unflushed"] = static_cast<double>(writer.stats().written - stats.written);
+        reportLatency(state, stats.flush);
+    }
+    BENCHMARK(BM_PriceWriterCycle)->Arg(5)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // One cycle appended to the memory-mapped tick journal, the
+    // alternative to SQLite price rows
+    static void BM_TickJournalAppend(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        ScratchJournal scratch("journal_append");
+        TickJournal journal(universe.symbols, scratch.config);
+        const auto ticks = universe.cycle();
+
+        for (auto _ : state) {
+            journal.append(ticks);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ticks.size()));
+    }
+    BENCHMARK(BM_TickJournalAppend)->Apply(symbolCounts);
+
+    // Full-history scan for one symbol after 1M journaled ticks
+    static void BM_TickJournalHistory(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        ScratchJournal scratch("journal_history");
+        TickJournal journal(universe.symbols, scratch.config);
+        for (size_t written = 0; written < 1000000; written += universe.ids.size()) {
+            journal.append(universe.cycle());
+        }
+
+        size_t points = 0;
+        for (auto _ : state) {
+            auto history = journal.history(universe.ids.front(), PriceStore::TimePoint::min(), PriceStore::TimePoint::max());
+            points = history.size();
+            benchmark::DoNotOptimize(history.data());
+        }
+        state.counters["points"] = static_cast<double>(points);
+    }
+    BENCHMARK(BM_TickJournalHistory)->Arg(5)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+    // The poll-mode tick path minus DataService itself: generate a cycle,
+    // convert each tick, queue it for the CLI and the database. Arguments
+    // are the symbol count and the target ticks/sec (0 = as fast as
+    // possible); the latency counters are queued-to-sent on the publisher.
+    static void BM_PublishLoop(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        const int64_t ticks_per_second = state.range(1);
+        ScratchDatabase scratch("publish_loop");
+        DatabaseMutex db_mutex;
+        BarStore bars(scratch.path(), DatabaseTuningConfig{}, universe.symbols, db_mutex);
+        SqlitePriceStore store(scratch.path(), DatabaseTuningConfig{}, db_mutex, universe.symbols);
+        PriceWriter writer(store, bars);
+        MessagePublisher publisher(benchPublisherConfig());
+
+        std::vector<Tick> ticks;
+        ticks.reserve(universe.ids.size());
+        uint64_t queued = 0;
+
+        for (auto _ : state) {
+            auto cycle_start = Clock::now();
+            ticks.clear();
+            universe.provider.generateTicks(universe.ids.data(), universe.ids.size(), ticks);
+
+            for (const auto& tick : ticks) {
+                StockQuote quote{ universe.symbols.name(tick.symbol), tick.price, tick.timestamp };
+                quote.change_percent = tick.change_percent;
+                writer.enqueue(tick);
+                publisher.sendQuote(tick.symbol, std::move(quote));
+            }
+            queued += ticks.size();
+            pace(cycle_start, ticks.size(), ticks_per_second);
+        }
+        if (!waitUntilSent(publisher, queued)) {
+            state.SkipWithError("Publisher did not send every queued quote");
+            return;
+        }
+
+        auto stats = publisher.stats();
+        state.SetItemsProcessed(static_cast<int64_t>(queued));
+        state.counters["max_queue_depth"] = static_cast<double>(stats.max_queue_depth);
+        state.counters["db_dropped"] = static_cast<double>(writer.stats().dropped);
+        reportLatency(state, stats.latency);
+    }
+    BENCHMARK(BM_PublishLoop)
+        ->ArgsProduct({ { 5, 1000, 100000 }, { 0, 100000, 1000000 } })
+        ->ArgNames({ "symbols", "ticks_per_sec" })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
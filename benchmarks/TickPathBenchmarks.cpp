@@ -0,0 +1,105 @@
+// StockTracker.DataService/benchmarks/TickPathBenchmarks.cpp
+//
+// The per-tick stages in isolation: generation, conversion into the CLI's
+// currency, and building what goes on the wire.
+#include "BenchmarkSupport.h"
+#include "QuoteWire.h"
+#include "StockTracker/Messages.h"
+
+namespace StockTracker::Benchmarks {
+
+    // MockDataProvider::generateTicks() over every symbol, one poll cycle
+    // per iteration. Allocation-free once every symbol has ticked.
+    static void BM_GenerateTicks(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        auto ticks = universe.cycle();
+
+        AllocationCheck allocations;
+        for (auto _ : state) {
+            ticks.clear();
+            universe.provider.generateTicks(universe.ids.data(), universe.ids.size(), ticks);
+            benchmark::DoNotOptimize(ticks.data());
+        }
+        const int64_t items = state.iterations() * static_cast<int64_t>(universe.ids.size());
+        allocations.check(state, items);
+        state.SetItemsProcessed(items);
+    }
+    BENCHMARK(BM_GenerateTicks)->Apply(symbolCounts);
+
+    // What DataService::makeQuote() does per tick: resolve the name and
+    // convert at a cached FX rate
+    static void BM_ConvertQuote(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        const auto ticks = universe.cycle();
+        const double rate = 0.92;  // Stands in for FxRateCache::rate("EUR")
+
+        for (auto _ : state) {
+            for (const auto& tick : ticks) {
+                StockQuote quote{ universe.symbols.name(tick.symbol), tick.price * rate, tick.timestamp };
+                quote.change_percent = tick.change_percent;
+                quote.currency = "EUR";
+                benchmark::DoNotOptimize(quote);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ticks.size()));
+    }
+    BENCHMARK(BM_ConvertQuote)->Apply(symbolCounts);
+
+    // Building the CLI's QuoteUpdate message, as the publisher thread does
+    static void BM_MakeQuoteUpdate(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        std::vector<StockQuote> quotes;
+        for (const auto& tick : universe.cycle()) {
+            quotes.push_back(StockQuote{ universe.symbols.name(tick.symbol), tick.price, tick.timestamp });
+        }
+
+        for (auto _ : state) {
+            for (const auto& quote : quotes) {
+                auto message = Message::makeQuoteUpdate(quote);
+                benchmark::DoNotOptimize(message);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(quotes.size()));
+    }
+    BENCHMARK(BM_MakeQuoteUpdate)->Apply(symbolCounts);
+
+    // Topic feed payloads (see QuoteFeed): text, then fixed-size binary.
+    // Both reuse their buffers and must not allocate.
+    static void BM_EncodeText(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        const auto ticks = universe.cycle();
+        fmt::memory_buffer out;
+
+        AllocationCheck allocations;
+        for (auto _ : state) {
+            for (const auto& tick : ticks) {
+                out.clear();
+                QuoteWire::encodeText(out, universe.symbols.name(tick.symbol), tick.price,
+                    tick.change_percent, tick.timestamp, "USD");
+                benchmark::DoNotOptimize(out.data());
+            }
+        }
+        const int64_t items = state.iterations() * static_cast<int64_t>(ticks.size());
+        allocations.check(state, items);
+        state.SetItemsProcessed(items);
+    }
+    BENCHMARK(BM_EncodeText)->Apply(symbolCounts);
+
+    static void BM_EncodeBinary(benchmark::State& state) {
+        MockUniverse universe(static_cast<size_t>(state.range(0)));
+        const auto ticks = universe.cycle();
+        unsigned char out[QuoteWire::BinaryQuoteSize];
+
+        AllocationCheck allocations;
+        for (auto _ : state) {
+            for (const auto& tick : ticks) {
+                QuoteWire::encodeBinary(out, tick.symbol, "USD", tick.price, tick.change_percent, tick.timestamp);
+                benchmark::DoNotOptimize(out);
+            }
+        }
+        const int64_t items = state.iterations() * static_cast<int64_t>(ticks.size());
+        allocations.check(state, items);
+        state.SetItemsProcessed(items);
+    }
+    BENCHMARK(BM_EncodeBinary)->Apply(symbolCounts);
+}
@@ -0,0 +1,20 @@
+// StockTracker.DataService/benchmarks/main.cpp
+#include "Logging.h"
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv) {
+    // Keep the service's own logging out of the timings and the report
+    StockTracker::LoggingConfig logging;
+    logging.level = spdlog::level::warn;
+    StockTracker::configureLogging(logging);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    StockTracker::shutdownLogging();
+    return 0;
+}
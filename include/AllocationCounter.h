@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+namespace StockTracker::AllocationCounter {
+
+    // Built with STOCKTRACKER_COUNT_ALLOCATIONS (Debug configurations), the
+    // global operator new counts heap allocations per thread so the tick
+    // path can check that steady-state ticks do not allocate.
+#ifdef STOCKTRACKER_COUNT_ALLOCATIONS
+    constexpr bool enabled = true;
+#else
+    constexpr bool enabled = false;
+#endif
+
+    // Allocations made by the calling thread so far (always 0 when disabled)
+    uint64_t threadAllocations();
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "DatabaseMutex.h"
+#include "Rollup.h"
+#include "SqliteConnection.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace StockTracker {
+
+    // Closed rollup bars in their own table of the service database. Uses a
+    // separate SQLite connection because DatabaseService only knows about
+    // raw prices and subscriptions. Writes hold the database mutex.
+    class BarStore {
+    private:
+        const SymbolTable& symbol_table;
+        DatabaseMutex& database_mutex;
+        mutable std::mutex mutex;  // Serializes use of the connection
+        mutable SqliteConnection connection;
+
+    public:
+        BarStore(const std::string& path, const DatabaseTuningConfig& tuning, const SymbolTable& symbol_table,
+            DatabaseMutex& database_mutex);
+
+        // Insert or replace bars in one transaction
+        void save(const std::vector<RollupBar>& bars);
+
+        // The latest `limit` bars that start before `before`, oldest first
+        std::vector<RollupBar> load(SymbolId symbol, BarResolution resolution,
+            std::chrono::system_clock::time_point before, size_t limit) const;
+
+        // Bars that start in [from, to), oldest first
+        std::vector<RollupBar> range(SymbolId symbol, BarResolution resolution,
+            std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const;
+
+        BarStore(const BarStore&) = delete;
+        BarStore& operator=(const BarStore&) = delete;
+    };
+}
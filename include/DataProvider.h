@@ -0,0 +1,25 @@
+#pragma once
+#include "IStockDataProvider.h"
+#include "MockData.h"
+#include "RemoteDataProvider.h"
+#include "ReplayDataProvider.h"
+#include <memory>
+#include <string>
+
+namespace StockTracker {
+
+    struct DataProviderConfig {
+        std::string kind{ "mock" };  // "mock", "remote" or "replay"
+        MockProviderConfig mock;
+        RemoteProviderConfig remote;
+        ReplayProviderConfig replay;
+        size_t stream_capacity{ 65536 };  // Push-mode ring size, in ticks
+        size_t stream_batch_size{ 4096 }; // Most ticks drained per publish cycle
+    };
+
+    // Build the provider named by config.kind. `streams` is the number of
+    // tick generation shards, which the mock provider matches with
+    // independent generator streams.
+    std::unique_ptr<IStockDataProvider> makeDataProvider(const DataProviderConfig& config,
+        SymbolTable& symbol_table, size_t streams);
+}
@@ -2,39 +2,170 @@
 #include "StockTracker/Messages.h"
 #include "StockTracker/DatabaseService.h"
 #include "StockTracker/CurrencyService.h"
-#include "MockData.h"
+#include "IStockDataProvider.h"
+#include "TickStream.h"
+#include "SymbolTable.h"
+#include "Tick.h"
+#include "AllocationCounter.h"
+#include "DataServiceConfig.h"
+#include "DatabaseMutex.h"
+#include "MessagePublisher.h"
+#include "PriceStore.h"
+#include "PriceWriter.h"
+#include "BarStore.h"
+#include "PriceHistoryCache.h"
+#include "PriceHistoryQuery.h"
+#include "TickScheduler.h"
+#include "SubscriptionRegistry.h"
+#include "SubscriptionWriter.h"
+#include "SymbolPartition.h"
+#include "PartitionClient.h"
+#include "PublishForwarder.h"
+#include "FxRateCache.h"
+#include "LatencyHistogram.h"
+#include "LogRateLimiter.h"
+#include "LastValueTable.h"
+#include "MetricsServer.h"
+#include "QuoteFeed.h"
+#include "RollupEngine.h"
+#include "RequestServer.h"
+#include "RetentionManager.h"
+#include "ShardPool.h"
 #include <sqlite3.h>
-#include <unordered_set>
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace StockTracker {
     class DataService {
     private:
         MessageSocket subscriber;   // Receives commands from CLI
-        MessageSocket publisher;    // Sends updates to CLI
-        MockDataProvider mock_data; // mock stock data
-        DatabaseService db_service; // Manages SQLite interactions
+        MessagePublisher publisher; // Sends updates to CLI (owns the PUB socket)
+        MessageSocket wakeup;       // Connected to subscriber; stop() sends on it
+        std::mutex wakeup_mutex;
+        SymbolTable symbol_table;   // Ticker <-> SymbolId for everything below
+        const SymbolPartition partition; // Which tickers this instance serves
+        std::unique_ptr<PartitionClient> peers; // Partitioned coordinator only; command thread
+        std::unique_ptr<TickStream> tick_stream; // Push mode only; declared first so it outlives the provider's feed thread
+        std::unique_ptr<IStockDataProvider> data_provider; // Chosen by config.provider
+        DatabaseService db_service; // Persisted subscriptions (StockTracker.Common's schema)
+        DatabaseMutex database_mutex; // Held for every db_service call
+        SubscriptionWriter subscription_writer; // Coalesced, asynchronous subscription persistence
+        BarStore bar_store;         // Closed rollup bars (own SQLite connection)
+        std::unique_ptr<PriceStore> price_store; // Persisted ticks: SQLite rows or the tick journal
+        PriceWriter price_writer;   // Batches price writes off the tick path
+        std::unique_ptr<RollupEngine> rollups; // Per-symbol OHLC bars, fed by the update thread
+        std::unique_ptr<RetentionManager> retention; // Background deletes of expired ticks and bars
+        PriceHistoryCache history_cache; // Recent persisted prices, served without SQLite
         CurrencyService currency_service;
-        std::string current_currency{ "USD" };
-        std::unordered_set<std::string> subscribed_stocks;
+        FxRateCache fx_rates;       // Cached USD rates so conversion never blocks a tick
+        mutable std::mutex currency_mutex;
+        std::string current_currency{ "USD" };  // Guarded by currency_mutex
+        // Held for a whole subscribe or unsubscribe, from the command thread or
+        // the request server, so the registry, scheduler, last quotes,
+        // persisted list and confirmations change together
+        std::mutex subscription_mutex;
+        SubscriptionRegistry subscribed_stocks; // Written under subscription_mutex, snapshotted by the update thread
+        TickScheduler tick_scheduler; // Decides when each subscribed symbol updates
+        LastValueTable last_quotes;   // Latest USD quote per symbol
+        std::unique_ptr<QuoteFeed> quote_feed; // Per-currency topic stream (update thread only)
+        const size_t legacy_history_max_points;
+        const size_t stream_batch_size;
         std::atomic<bool> running{ true };
+        // Per-tick failures are logged at most once per interval
+        mutable LogRateLimiter conversion_error_log;
+        LogRateLimiter publish_error_log;
+        // Per-stage timings for the METRICS request; the publisher and price
+        // writer keep their own
+        const std::chrono::steady_clock::time_point started{ std::chrono::steady_clock::now() };
+        std::atomic<uint64_t> ticks_published{ 0 };
+        LatencyHistogram provider_latency;  // One generateTicks() batch per shard
+        LatencyHistogram convert_latency;   // makeQuote(): name lookup and FX conversion
+        LatencyHistogram tick_latency;      // publishUpdate(): convert, queue for CLI and DB
+        // Debug builds: heap allocations seen on steady-state ticks (should stay 0)
+        std::atomic<uint64_t> hot_path_allocations{ 0 };
+
+        // Update thread scratch buffers
+        std::vector<SymbolId> due_ids;
+        std::vector<Tick> due_ticks;
+
+        // Tick generation workers, and the ticks each shard produced this cycle
+        ShardPool generators;
+        std::vector<std::vector<Tick>> shard_ticks;
+
+        std::unique_ptr<PublishForwarder> forwarder; // Merged publishers of every partition member
+
+        // Last member: constructed once the rest of the service is ready and
+        // destroyed (stopping its thread) before anything it calls into
+        std::unique_ptr<RequestServer> request_server;
+        std::unique_ptr<MetricsServer> metrics_server; // HTTP scrape endpoint for the same METRICS text
 
         // Message handling
         void handleMessage(const Message& msg);
         void subscribeStock(const std::string& symbol);
         void unsubscribeStock(const std::string& symbol);
+        // Bulk forms: one registry update and one persisted write for the
+        // whole list. Already-subscribed (or not subscribed) symbols are
+        // skipped quietly. Return how many symbols changed.
+        size_t subscribeMany(const std::vector<std::string>& symbols);
+        size_t unsubscribeMany(const std::vector<std::string>& symbols);
         void queryStock(const std::string& symbol);
+        // Every subscribed price again in the current currency (command or
+        // FX refresh thread)
+        void resendQuotes();
         void sendPriceHistory(const std::string& symbol);
         void sendSubscriptionsList();
+        // The symbols this instance serves, in order
+        std::vector<std::string> ownedSymbols(const std::vector<std::string>& symbols) const;
+        std::vector<std::string> subscribedSymbols() const;
+
+        // History from the in-memory cache, plus price store points older than it
+        // (and before `to`) unless `from` falls inside the cached window
+        std::vector<PriceHistoryCache::Point> loadHistory(const std::string& symbol,
+            std::optional<std::chrono::system_clock::time_point> from,
+            std::optional<std::chrono::system_clock::time_point> to);
+        // Bars at a maintained rollup resolution that start inside the query
+        // range: persisted ones from the bar store, then those in memory
+        std::vector<PriceBar> loadRollupHistory(const PriceHistoryQuery& query);
+
+        // Request endpoint (runs on the request server thread)
+        std::string handleRequest(const std::string& request);
+        std::string queryHistory(const PriceHistoryQuery& query);
+        std::string queryRollups(const std::string& symbol, BarResolution resolution, size_t count);
+        std::string querySnapshot(const std::string& currency, const std::vector<std::string>& symbols);
+        std::string queryMetrics() const;
+        std::string queryPartition() const;
+        std::string queryOwners(const std::vector<std::string>& symbols) const;
+
+        // Generate ticks for a batch of due symbols across the shards, then
+        // feed the topic stream and rollups from this thread
+        void updateStocks(const std::vector<SymbolId>& symbols);
+        // One shard's part of a cycle: generate, convert, publish and store
+        void generateShard(size_t shard, const std::vector<SymbolId>& ids);
+        void publishUpdate(const Tick& tick);
+
+        // Update thread loops: scheduler-driven polling of the provider, or
+        // draining a streaming provider's ticks as they arrive
+        void pollUpdates();
+        void streamUpdates();
+        void publishStreamed(const std::vector<Tick>& ticks);
+
+        // Fresh USD tick for one symbol, recorded as its last value
+        Tick generateTick(SymbolId id);
+        // The wire/DB boundary: a ticker-named StockQuote, built once and
+        // directly in the CLI's currency
+        StockQuote makeQuote(const Tick& tick) const;
+        // Send on the legacy socket and store
+        void publishLegacy(const Tick& tick);
 
-        StockQuote convertQuoteCurrency(const StockQuote& quote);
+        std::string currentCurrency() const;
 
         // Data storage (for SQLite)
-        void storeStockPrice(const std::string& symbol, double price,
+        void storeStockPrice(SymbolId symbol, double price,
             const std::chrono::system_clock::time_point& timestamp);
 
     public:
-        DataService();
+        explicit DataService(const DataServiceConfig& config = DataServiceConfig{});
 
         void run();
         void stop();
@@ -0,0 +1,68 @@
+#pragma once
+#include "DataProvider.h"
+#include "FxRateCache.h"
+#include "Logging.h"
+#include "MessagePublisher.h"
+#include "MetricsServer.h"
+#include "PriceHistoryCache.h"
+#include "PriceWriter.h"
+#include "PublishForwarder.h"
+#include "QuoteFeed.h"
+#include "RequestServer.h"
+#include "RetentionManager.h"
+#include "RollupEngine.h"
+#include "ShardPool.h"
+#include "SqliteConnection.h"
+#include "SubscriptionWriter.h"
+#include "SymbolPartition.h"
+#include "TickJournal.h"
+#include "TickScheduler.h"
+#include <cstdint>
+#include <string>
+
+namespace StockTracker {
+
+    // Tunables for a DataService instance. By default only the original
+    // endpoints listen (commands on 5557, CLI updates on 5556, plus a
+    // loopback wakeup port); the topic feed, request, metrics and forwarder
+    // endpoints are opt-in. In-process rollups are on.
+    struct DataServiceConfig {
+        std::string database_path{ "stocktracker.db" };
+        LoggingConfig logging;  // Applied by main() via configureLogging()
+        // The CLI's PUB socket, which commands arrive on. Every partition
+        // member connects to it and acts only on the symbols it owns.
+        std::string command_endpoint{ "tcp://localhost:5557" };
+        PartitionConfig partition;
+        PublishForwarderConfig forwarder;
+        DataProviderConfig provider;
+        // Loopback endpoint stop() publishes on to unblock the command loop.
+        // Empty: bind the first free port in [wakeup_first_port,
+        // wakeup_last_port], so several instances on one host (e.g.
+        // partition members) each get their own.
+        std::string wakeup_endpoint;
+        uint16_t wakeup_first_port{ 5560 };
+        uint16_t wakeup_last_port{ 5623 };
+        MessagePublisherConfig publisher;
+        DatabaseTuningConfig database;
+        PriceWriterConfig price_writer;
+        SubscriptionWriterConfig subscriptions;
+        TickJournalConfig tick_journal;  // Enabled: ticks go to the journal, SQLite keeps subscriptions and bars
+        TickSchedulerConfig tick_scheduler;
+        ShardPoolConfig generators;
+        FxRateCacheConfig fx_rates;
+        QuoteFeedConfig quote_feed;
+        PriceHistoryCacheConfig price_history;
+        RequestServerConfig request_server;
+        MetricsServerConfig metrics_server;  // Enabled: Prometheus scrapes http://<host>:<port>/metrics
+        RollupConfig rollups;
+        RetentionConfig retention;
+
+        // Load testing: subscribe to every symbol the provider offers at
+        // startup, without saving the subscriptions to SQLite
+        bool subscribe_all{ false };
+
+        // Cap on points in a legacy PriceHistory reply (0 = everything).
+        // Longer histories are downsampled to this many points.
+        size_t legacy_history_max_points{ 0 };
+    };
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <mutex>
+
+namespace StockTracker {
+
+    // Serializes use of the service database. DatabaseService (from
+    // StockTracker.Common) is not thread-safe, but the command thread, the
+    // request server and the subscription writer all call it. Every
+    // DatabaseService call holds the one DatabaseMutex the DataService owns.
+    //
+    // Writes on the connections this service opens (SqlitePriceStore,
+    // BarStore, retention) hold it too. DatabaseService's connection has no
+    // busy handler, so a write of its own that meets a write lock held by
+    // one of our connections would fail with SQLITE_BUSY straight away.
+    using DatabaseMutex = std::mutex;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "StockTracker/CurrencyService.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace StockTracker {
+
+    // What rate() does once a cached rate is older than max_staleness
+    enum class FxFallbackPolicy {
+        UseStale,        // Keep converting with the last known rate
+        UseBaseCurrency  // Stop converting; callers publish the USD price
+    };
+
+    struct FxRateCacheConfig {
+        std::chrono::milliseconds refresh_interval{ 60000 };
+        std::chrono::milliseconds max_staleness{ 300000 };
+        FxFallbackPolicy fallback_policy{ FxFallbackPolicy::UseStale };
+    };
+
+    struct FxRateStats {
+        uint64_t refreshes{ 0 };         // Rates fetched successfully, one per currency
+        uint64_t refresh_failures{ 0 };  // Rates that failed to fetch; the old rate is kept
+        uint64_t misses{ 0 };          // Lookups for a currency with no cached rate
+        uint64_t stale_lookups{ 0 };   // Lookups that hit a rate older than max_staleness
+        size_t currencies{ 0 };
+        double oldest_rate_age_ms{ 0.0 };
+    };
+
+    // In-process USD -> currency rate table. Rates are fetched from
+    // CurrencyService on a background thread and published by swapping in a
+    // new immutable table, so the tick path is a hash lookup and a multiply.
+    class FxRateCache {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        struct Rate {
+            double rate;
+            Clock::time_point updated;
+        };
+        using Table = std::unordered_map<std::string, Rate>;
+
+        CurrencyService& currency_service;
+        const FxRateCacheConfig config;
+
+        std::shared_ptr<const Table> table;  // Swapped atomically
+
+        std::mutex fetch_mutex;  // Serializes CurrencyService calls and table rebuilds
+        std::unordered_set<std::string> tracked;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        std::unordered_set<std::string> pending;  // Queued by track() and prefetch()
+        std::vector<std::function<void()>> waiting;  // track() callbacks for the next fetch
+        bool stopping{ false };
+
+        std::atomic<uint64_t> refreshes{ 0 };
+        std::atomic<uint64_t> refresh_failures{ 0 };
+        mutable std::atomic<uint64_t> misses{ 0 };
+        mutable std::atomic<uint64_t> stale_lookups{ 0 };
+
+        std::thread refresh_thread;
+
+        std::shared_ptr<const Table> load() const;
+        void refreshLoop();
+        void fetch(const std::unordered_set<std::string>& currencies);
+
+    public:
+        FxRateCache(CurrencyService& currency_service, const FxRateCacheConfig& config = FxRateCacheConfig{});
+        ~FxRateCache();
+
+        // Rate to convert a USD amount into `currency`, or nullopt if there is
+        // no usable cached rate. Never calls CurrencyService.
+        std::optional<double> rate(const std::string& currency) const;
+
+        // Add a currency to the refresh set. Never blocks: a rate that is
+        // not cached yet is fetched on the refresh thread, and rate() keeps
+        // returning nullopt until it arrives.
+        void prefetch(const std::string& currency);
+
+        // Like prefetch(), then calls on_ready once the rate is cached or the
+        // first fetch has failed: right away if it is cached already, else
+        // on the refresh thread
+        void track(const std::string& currency, std::function<void()> on_ready);
+
+        void stop();
+
+        FxRateStats stats() const;
+
+        FxRateCache(const FxRateCache&) = delete;
+        FxRateCache& operator=(const FxRateCache&) = delete;
+    };
+}
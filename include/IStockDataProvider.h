@@ -1,5 +1,9 @@
 #pragma once
 #include <StockTracker/Types.h>
+#include "SymbolTable.h"
+#include "Tick.h"
+#include "TickStream.h"
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -13,5 +17,28 @@ namespace StockTracker {
 		virtual StockQuote generateQuote(const std::string& symbol) = 0;
 		virtual bool isValidSymbol(const std::string& symbol) const = 0;
 		virtual std::vector<std::string> getAvailableSymbols() const = 0;
+
+		// Id-based hot path. Ids come from the SymbolTable the provider was
+		// constructed with.
+		virtual bool isValidSymbol(SymbolId id) const = 0;
+		// Append one USD tick per id to `out`
+		virtual void generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) = 0;
+
+		// Asynchronous batch contract: `done` receives a tick for every id the
+		// provider could quote, possibly later and on a provider thread.
+		// Networked providers override this to keep many requests in flight;
+		// the default answers inline from generateTicks.
+		using TickHandler = std::function<void(std::vector<Tick> ticks)>;
+		virtual void requestTicks(std::vector<SymbolId> ids, TickHandler done) {
+			std::vector<Tick> ticks;
+			generateTicks(ids.data(), ids.size(), ticks);
+			done(std::move(ticks));
+		}
+
+		// Push mode: a provider backed by a streaming feed starts delivering
+		// every tick it receives into `stream` (from a single feed thread)
+		// and returns true. Poll-only providers return false and are driven
+		// by the tick scheduler instead.
+		virtual bool startStreaming(TickStream& /*stream*/) { return false; }
 	};
 }
\ No newline at end of file
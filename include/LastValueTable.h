@@ -0,0 +1,27 @@
+#pragma once
+#include "Tick.h"
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace StockTracker {
+
+    // Latest base-currency (USD) tick per symbol, written by the update
+    // thread and read by the command thread, so display-only requests can
+    // be answered from memory instead of generating and storing a new tick.
+    class LastValueTable {
+    private:
+        mutable std::mutex mutex;
+        std::unordered_map<SymbolId, Tick> ticks;
+
+    public:
+        // Returns true if this is the symbol's first tick
+        bool update(const Tick& tick);
+        void erase(SymbolId symbol);
+        std::optional<Tick> get(SymbolId symbol) const;
+
+        // Append every symbol's latest tick to `out`, in no particular order
+        void snapshot(std::vector<Tick>& out) const;
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace StockTracker {
+
+    // Point-in-time view of a LatencyHistogram, in nanoseconds
+    struct LatencySummary {
+        uint64_t count{ 0 };
+        uint64_t sum_ns{ 0 };
+        uint64_t max_ns{ 0 };
+        uint64_t p50_ns{ 0 };
+        uint64_t p99_ns{ 0 };
+        uint64_t p999_ns{ 0 };
+    };
+
+    // HDR-style log-linear histogram: each power of two is split into 16
+    // linear buckets, so any recorded value is reported within ~6%.
+    // record() is a few relaxed atomic adds and never locks or allocates, so
+    // it can sit on the tick path and be summarized from another thread.
+    class LatencyHistogram {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr unsigned sub_bucket_bits = 4;
+        static constexpr size_t sub_buckets = size_t{ 1 } << sub_bucket_bits;
+        static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+    private:
+        std::array<std::atomic<uint64_t>, bucket_count> buckets{};
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> sum_ns{ 0 };
+        std::atomic<uint64_t> max_ns{ 0 };
+
+        static size_t bucketFor(uint64_t ns);
+        static uint64_t bucketUpperBound(size_t bucket);
+
+    public:
+        LatencyHistogram() = default;
+
+        void record(std::chrono::nanoseconds elapsed);
+
+        // Time since `start`, for the common measure-a-stage case
+        void recordSince(Clock::time_point start) {
+            record(Clock::now() - start);
+        }
+
+        // Percentiles are bucket upper bounds, capped at the recorded max.
+        // Concurrent record() calls may or may not be included.
+        LatencySummary summary() const;
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    };
+}
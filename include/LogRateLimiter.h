@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace StockTracker {
+
+    // Lets one message through per interval and counts the rest, for errors
+    // that can repeat on every tick (conversion failures, a dead socket).
+    // Lock-free; one limiter per call site.
+    class LogRateLimiter {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        const Clock::duration interval;
+        std::atomic<Clock::rep> next_allowed{ 0 };
+        std::atomic<uint64_t> suppressed_count{ 0 };
+
+    public:
+        explicit LogRateLimiter(std::chrono::milliseconds interval = std::chrono::seconds(5))
+            : interval(interval) {}
+
+        // True if the caller should log now. `suppressed` receives how many
+        // messages were held back since the last one that got through.
+        bool allow(uint64_t& suppressed) {
+            const Clock::rep now = Clock::now().time_since_epoch().count();
+            Clock::rep next = next_allowed.load(std::memory_order_relaxed);
+            if (now >= next && next_allowed.compare_exchange_strong(next, now + interval.count(),
+                std::memory_order_relaxed)) {
+                suppressed = suppressed_count.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+            suppressed_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        LogRateLimiter(const LogRateLimiter&) = delete;
+        LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <spdlog/common.h>
+#include <cstddef>
+
+namespace StockTracker {
+
+    struct LoggingConfig {
+        // Format and write on a background thread; the tick path only
+        // enqueues. false = synchronous console logging as before.
+        bool async{ true };
+        size_t queue_size{ 8192 };  // Messages; when full the oldest is dropped
+        spdlog::level::level_enum level{ spdlog::level::info };
+    };
+
+    // Install the process-wide default logger. Call once, before any other
+    // StockTracker object is created.
+    void configureLogging(const LoggingConfig& config = LoggingConfig{});
+
+    // Drain the async queue and stop its thread. Call last, before exit.
+    void shutdownLogging();
+}
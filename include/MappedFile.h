@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace StockTracker {
+
+    // A file mapped read-write into memory, created or grown to a given
+    // size when opened and resizable afterwards. Throws std::runtime_error
+    // if the file cannot be opened, sized or mapped.
+    class MappedFile {
+    private:
+        std::string file_path;
+        void* base{ nullptr };
+        size_t length{ 0 };
+#ifdef _WIN32
+        void* file_handle{ nullptr };
+        void* mapping_handle{ nullptr };
+#else
+        int fd{ -1 };
+#endif
+
+        void map();
+        void unmap();
+        void close();
+
+    public:
+        // Map `path`, extending it with zeros to at least `size` bytes
+        MappedFile(const std::string& path, size_t size);
+        ~MappedFile();
+
+        unsigned char* data() const { return static_cast<unsigned char*>(base); }
+        size_t size() const { return length; }
+        const std::string& path() const { return file_path; }
+
+        // Write dirty pages in [offset, offset + count) back to the file
+        void flush(size_t offset, size_t count);
+
+        // Grow (with zeros) or truncate the file to `size` bytes and map it
+        // again; data() changes. Windows extends a mapped file to its full
+        // size on disk, so callers grow in steps and trim what they did not
+        // use.
+        void resize(size_t size);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+    };
+}
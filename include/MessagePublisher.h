@@ -0,0 +1,135 @@
+#pragma once
+#include "StockTracker/Messages.h"
+#include "LatencyHistogram.h"
+#include "LogRateLimiter.h"
+#include "SymbolTable.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace StockTracker {
+
+    struct MessagePublisherConfig {
+        std::string endpoint{ "tcp://*:5556" };
+        size_t queue_capacity{ 65536 };  // sendQuote() waits for room beyond this
+
+        // Keep only the latest pending quote per symbol and send quotes at
+        // most once per conflation_interval, so a slow CLI sees fresh prices
+        // instead of ZeroMQ dropping whatever overflows its high-water mark.
+        // Control messages (replies, errors) are never conflated and skip
+        // the wait.
+        bool conflate_quotes{ false };
+        std::chrono::milliseconds conflation_interval{ 100 };
+    };
+
+    struct MessagePublisherStats {
+        uint64_t sent{ 0 };
+        uint64_t wakeups{ 0 };           // Drains; sent / wakeups is the coalescing factor
+        uint64_t conflated{ 0 };         // Quotes replaced by a newer one before sending
+        size_t pending_quotes{ 0 };      // Occupied last-value slots
+        size_t queue_depth{ 0 };
+        size_t max_queue_depth{ 0 };
+        double last_latency_us{ 0.0 };   // Queued -> handed to ZeroMQ
+        double max_latency_us{ 0.0 };
+        LatencySummary latency;          // Queued -> handed to ZeroMQ, per message
+    };
+
+    // Sole owner of the CLI PUB socket. ZeroMQ sockets must not be used
+    // from several threads at once, so the command, update and request
+    // threads queue messages here and one publisher thread sends them,
+    // draining everything that queued up since its last wakeup in one go.
+    //
+    // Control messages (replies, errors, confirmations) have a queue of
+    // their own that is never conflated or bounded, and each wakeup sends
+    // all of it before any quote. They share the PUB socket with quotes,
+    // though, and a PUB socket drops whatever arrives while a subscriber's
+    // pipe is at its high-water mark. So control traffic is guaranteed to
+    // reach ZeroMQ first and never to wait behind a quote backlog; delivery
+    // to a subscriber that has already filled its pipe is not guaranteed.
+    class MessagePublisher {
+    private:
+        // A control message, or a quote moved ahead of a control message
+        // about its symbol. Quotes are kept as-is and turned into a Message
+        // on the publisher thread, keeping message construction off the
+        // tick path.
+        struct Pending {
+            std::variant<Message, StockQuote> payload;
+            std::chrono::steady_clock::time_point queued;
+        };
+
+        // A quote in the unconflated quote queue
+        struct QueuedQuote {
+            SymbolId symbol;
+            StockQuote quote;
+            std::chrono::steady_clock::time_point queued;
+        };
+
+        // Last-value slot; the message is built only when the quote is sent
+        struct PendingQuote {
+            StockQuote quote;
+            std::chrono::steady_clock::time_point queued;  // Of the first quote the slot held
+            bool occupied{ false };
+        };
+
+        const MessagePublisherConfig config;
+        MessageSocket socket;  // Used only by publisher_thread after construction
+
+        mutable std::mutex queue_mutex;
+        std::condition_variable queue_ready;
+        std::condition_variable queue_space;
+        // Both queues are swapped with the publisher's batch buffers, so
+        // each side keeps its capacity
+        std::vector<Pending> control;      // Sent first on every wakeup
+        std::vector<QueuedQuote> quotes;   // Quotes when not conflating
+        // Conflation slots indexed by SymbolId. They persist across flushes,
+        // so a symbol seen before never allocates on the tick path again.
+        std::vector<PendingQuote> quote_slots;
+        std::vector<SymbolId> quote_order;  // Occupied slots in first-arrival order
+        bool stopping{ false };
+
+        std::atomic<uint64_t> sent{ 0 };
+        std::atomic<uint64_t> wakeups{ 0 };
+        std::atomic<uint64_t> conflated{ 0 };
+        std::atomic<size_t> max_queue_depth{ 0 };
+        std::atomic<double> last_latency_us{ 0.0 };
+        std::atomic<double> max_latency_us{ 0.0 };
+        LatencyHistogram latency;
+
+        LogRateLimiter send_error_log;  // A dead socket fails every message
+
+        std::thread publisher_thread;
+
+        void enqueue(Message message, std::optional<SymbolId> symbol = std::nullopt);
+        void publishLoop();
+        void transmit(const Message& message, std::chrono::steady_clock::time_point queued);
+
+    public:
+        explicit MessagePublisher(const MessagePublisherConfig& config = MessagePublisherConfig{});
+        ~MessagePublisher();
+
+        // Queue a message for the CLI; safe from any thread
+        void send(Message message);
+        // A control message about `symbol` (e.g. its Unsubscribe
+        // confirmation). Quotes for it still waiting to be sent are moved
+        // ahead of it, so they reach the CLI in order.
+        void send(Message message, SymbolId symbol);
+
+        // Queue a quote update for `symbol`; conflated per symbol when enabled
+        void sendQuote(SymbolId symbol, StockQuote quote);
+
+        // Send whatever is queued and stop the publisher thread
+        void stop();
+
+        MessagePublisherStats stats() const;
+
+        MessagePublisher(const MessagePublisher&) = delete;
+        MessagePublisher& operator=(const MessagePublisher&) = delete;
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <zmq.hpp>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace StockTracker {
+
+    struct MetricsServerConfig {
+        bool enabled{ false };
+        std::string endpoint{ "tcp://*:9464" };
+    };
+
+    // Minimal HTTP endpoint so Prometheus can scrape the METRICS text
+    // directly. A ZeroMQ STREAM socket accepts plain TCP connections; each
+    // "GET /metrics" gets one HTTP/1.0 reply with the handler's text, then
+    // the connection is closed. Anything else gets a 404 or 405. The
+    // handler runs on this server's own thread.
+    class MetricsServer {
+    public:
+        using Handler = std::function<std::string()>;
+
+    private:
+        static constexpr size_t max_request_bytes = 8192;
+
+        const MetricsServerConfig config;
+        Handler handler;
+
+        zmq::context_t context;
+        zmq::socket_t socket;
+        std::atomic<bool> running{ true };
+        std::thread server_thread;
+        // Request bytes received so far, by peer routing id (server thread only)
+        std::unordered_map<std::string, std::string> partial;
+
+        void serve();
+        void handleOne();
+        void reply(const std::string& peer, const char* status, const std::string& body);
+
+    public:
+        MetricsServer(const MetricsServerConfig& config, Handler handler);
+        ~MetricsServer();
+
+        void stop();
+
+        MetricsServer(const MetricsServer&) = delete;
+        MetricsServer& operator=(const MetricsServer&) = delete;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "LatencyHistogram.h"
+#include <spdlog/fmt/fmt.h>
+#include <cstdint>
+#include <string>
+
+namespace StockTracker {
+
+    // Builds a Prometheus text-format (0.0.4) exposition. Metric names get
+    // the "stocktracker_" prefix; latencies are reported in seconds.
+    class MetricsText {
+    private:
+        fmt::memory_buffer out;
+
+        void header(const char* name, const char* help, const char* type);
+
+    public:
+        void counter(const char* name, const char* help, uint64_t value);
+        void gauge(const char* name, const char* help, double value);
+        // Summary with 0.5 / 0.99 / 0.999 quantiles, plus _sum, _count and a
+        // separate <name>_max gauge
+        void summary(const char* name, const char* help, const LatencySummary& latency);
+
+        std::string str() const;
+    };
+}
@@ -1,39 +1,112 @@
 #pragma once
 #include "IStockDataProvider.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <random>
-#include <unordered_map>
 
 namespace StockTracker {
 
-	class MockDataProvider: public IStockDataProvider {
-	private:
-		std::mt19937 rng{ std::random_device{}() };
+	// Generated symbols (SYN000000, SYN000001, ...) on top of the built-in
+	// tickers, for load and capacity testing. Each symbol's parameters are
+	// drawn once from these distributions.
+	struct SyntheticUniverseConfig {
+		size_t symbols{ 0 };
+		double min_price{ 5.0 };            // Base price, uniform
+		double max_price{ 500.0 };
+		double min_volatility{ 0.001 };     // Per-tick standard deviation, uniform
+		double max_volatility{ 0.004 };
+		double trend_mean{ 0.0 };           // Per-tick drift, normal
+		double trend_stddev{ 0.0001 };
+	};
 
+	struct MockProviderConfig {
+		// Fixed seed: the same universe and the same price paths on every run
+		// and machine. Each symbol draws from its own generator seeded from
+		// (seed, SymbolId), so its path depends only on how often it has
+		// ticked, not on batching or the shard count. 0 seeds from std::random_device.
+		uint64_t seed{ 0 };
+		SyntheticUniverseConfig synthetic;
+	};
 
+	class MockDataProvider: public IStockDataProvider {
+	private:
 		struct StockConfig {
 			double base_price;
 			double volatility; // How much the price can change
 			double trend; // The general price direction (positive=up, negative=down)
 		};
 
-		// Keep track of last prices so we can calculate changes
-		std::unordered_map<std::string, double> last_prices;
+		SymbolTable& symbol_table;
+
+		// Per-symbol state in structure-of-arrays layout, indexed by SymbolId,
+		// so batch generation walks contiguous arrays instead of hash lookups
+		std::vector<uint8_t> known;  // Symbols this provider can quote
+		std::vector<double> base_prices;
+		std::vector<double> volatilities;
+		std::vector<double> trends;
+
+		// Keep track of last prices so we can calculate changes (0 until the first quote)
+		std::vector<double> last_prices;
+
+		// Per-symbol splitmix64 generator state
+		uint64_t seed{ 0 };
+		std::vector<uint64_t> rng_states;
+
+		std::vector<SymbolId> available;
+
+		// Independent generator lanes. Symbol id % streams.size() picks the
+		// stream that owns a symbol; its mutex guards the symbol's
+		// rng_states and last_prices entries, so shards that own disjoint
+		// streams never contend.
+		struct Stream {
+			std::mutex mutex;
+
+			// Scratch space for batch generation
+			std::vector<double> uniforms;
+			std::vector<double> normals;
+			std::vector<double> batch_prices;
+			std::vector<double> batch_changes;
+		};
+		std::vector<std::unique_ptr<Stream>> streams;
+
+		void addSymbol(const std::string& symbol, const StockConfig& config);
+		void addSyntheticSymbols(const SyntheticUniverseConfig& config, std::mt19937_64& rng);
 
-		// Config for each stock
-		const std::unordered_map<std::string, StockConfig> stock_configs;
+		Stream& streamFor(SymbolId id) { return *streams[id % streams.size()]; }
+
+		// Fill stream.normals[0, count) with one standard normal per id, each
+		// from that symbol's own generator
+		void fillNormals(Stream& stream, const SymbolId* ids, size_t count);
+
+		// Caller holds stream.mutex and every id belongs to the stream
+		void generatePrices(Stream& stream, const SymbolId* ids, size_t count, double* prices, double* change_percents);
+		void generateTicks(Stream& stream, const SymbolId* ids, size_t count, std::vector<Tick>& out);
+
+		size_t streamOf(SymbolId id) const { return id % streams.size(); }
 
 	public:
 
-		MockDataProvider();
+		// Use one stream per tick generation shard (see ShardPool)
+		explicit MockDataProvider(SymbolTable& symbol_table, size_t stream_count = 1,
+			const MockProviderConfig& config = MockProviderConfig{});
 
-		// Generate new quote with realistic price movement
+		// Generate new quote with realistic price movement. Safe from any
+		// thread: it takes the owning stream's lock, like generateTicks(),
+		// because the command thread quotes while the update thread batches.
 		StockQuote generateQuote(const std::string& symbol) override;
 
 		// Check if symbol exists
 		bool isValidSymbol(const std::string& symbol) const override;
+		bool isValidSymbol(SymbolId id) const override;
 
 		// Get list of available symbols
 		std::vector<std::string> getAvailableSymbols() const override;
+
+		// Safe from any thread. A shard's batch (every id in one stream)
+		// advances in a single pass under one lock; mixed batches lock the
+		// owning stream per id.
+		void generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) override;
 	};
 
 }
\ No newline at end of file
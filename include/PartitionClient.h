@@ -0,0 +1,30 @@
+#pragma once
+#include <zmq.hpp>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace StockTracker {
+
+    // Asks other partition members one request-endpoint question at a time
+    // and waits (up to a deadline) for all of their replies together. Used
+    // for the rare CLI requests whose answer spans every member, such as the
+    // subscriptions list. Not thread-safe.
+    class PartitionClient {
+    private:
+        zmq::context_t context;
+        const std::chrono::milliseconds timeout;
+
+    public:
+        explicit PartitionClient(std::chrono::milliseconds timeout = std::chrono::milliseconds(250));
+
+        // One reply per endpoint, in order; nullopt where the member did not
+        // answer in time
+        std::vector<std::optional<std::string>> requestAll(const std::vector<std::string>& endpoints,
+            const std::string& request);
+
+        PartitionClient(const PartitionClient&) = delete;
+        PartitionClient& operator=(const PartitionClient&) = delete;
+    };
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "SymbolTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace StockTracker {
+
+    struct PriceHistoryCacheConfig {
+        bool enabled{ true };
+        size_t depth{ 4096 };                   // Points kept per symbol
+        size_t max_bytes{ 256 * 1024 * 1024 };  // Symbols beyond this budget are not cached
+    };
+
+    struct PriceHistoryCacheStats {
+        size_t symbols{ 0 };
+        size_t points{ 0 };
+        size_t bytes{ 0 };          // Reserved ring storage
+        uint64_t hits{ 0 };         // Served entirely from memory
+        uint64_t partial_hits{ 0 }; // Recent points from memory, older rows from SQLite
+        uint64_t misses{ 0 };       // Nothing cached for the symbol
+    };
+
+    // Fixed-capacity ring of the most recent persisted prices per symbol,
+    // filled alongside the price writer so it mirrors what SQLite holds.
+    // History requests are answered from here and only go to SQLite for
+    // points older than the ring.
+    class PriceHistoryCache {
+    public:
+        struct Point {
+            std::chrono::system_clock::time_point timestamp;
+            double price;
+        };
+
+    private:
+        struct Ring {
+            std::vector<Point> points;  // Allocated to `depth` on first use
+            size_t head{ 0 };           // Index of the oldest point
+            size_t count{ 0 };
+            // True once SQLite is known to hold nothing older than points[head];
+            // cleared as soon as the ring overwrites a point
+            bool complete{ false };
+        };
+
+        const PriceHistoryCacheConfig config;
+
+        mutable std::mutex mutex;
+        std::vector<Ring> rings;  // Indexed by SymbolId
+        size_t symbols{ 0 };
+        size_t points{ 0 };
+
+        mutable std::atomic<uint64_t> hits{ 0 };
+        mutable std::atomic<uint64_t> partial_hits{ 0 };
+        mutable std::atomic<uint64_t> misses{ 0 };
+
+        size_t ringBytes() const { return config.depth * sizeof(Point); }
+
+    public:
+        explicit PriceHistoryCache(const PriceHistoryCacheConfig& config = PriceHistoryCacheConfig{});
+
+        void record(SymbolId symbol, double price, std::chrono::system_clock::time_point timestamp);
+
+        // Append the cached points for a symbol to `out`, oldest first.
+        // Returns true if they are the symbol's complete history; otherwise
+        // older rows (if any) have to come from SQLite.
+        bool read(SymbolId symbol, std::vector<Point>& out) const;
+
+        // SQLite had no rows older than `oldest`, the first point returned by
+        // read(), so later reads can skip the database
+        void markComplete(SymbolId symbol, std::chrono::system_clock::time_point oldest);
+
+        PriceHistoryCacheStats stats() const;
+    };
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "PriceHistoryCache.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace StockTracker {
+
+    // Bar width for aggregated history; Raw returns one bar per stored point
+    enum class BarResolution { Raw, Second, Minute, Hour };
+
+    std::optional<BarResolution> parseBarResolution(const std::string& text);
+    const char* toString(BarResolution resolution);
+    std::chrono::seconds barWidth(BarResolution resolution);
+
+    struct PriceHistoryQuery {
+        std::string symbol;
+        std::optional<std::chrono::system_clock::time_point> from;  // Inclusive
+        std::optional<std::chrono::system_clock::time_point> to;    // Exclusive
+        size_t max_points{ 0 };  // 0 = no limit
+        BarResolution resolution{ BarResolution::Raw };
+    };
+
+    struct PriceBar {
+        std::chrono::system_clock::time_point start;
+        double open;
+        double high;
+        double low;
+        double close;
+        uint32_t count;
+    };
+
+    // Aggregate time-ordered points into bars for the query's range and
+    // resolution. If that yields more than max_points bars, neighbouring
+    // bars are merged so the whole range still fits in max_points.
+    std::vector<PriceBar> aggregateBars(const std::vector<PriceHistoryCache::Point>& points,
+        const PriceHistoryQuery& query);
+
+    // Merge neighbouring time-ordered bars until at most max_points remain
+    // (0 = no limit)
+    std::vector<PriceBar> fitBars(std::vector<PriceBar> bars, size_t max_points);
+}
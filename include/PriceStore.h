@@ -0,0 +1,52 @@
+#pragma once
+#include "DatabaseMutex.h"
+#include "LogRateLimiter.h"
+#include "PriceHistoryCache.h"
+#include "SqliteConnection.h"
+#include "SymbolTable.h"
+#include "Tick.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace StockTracker {
+
+    // Where persisted ticks live. The price writer thread appends; command
+    // and request threads read history older than PriceHistoryCache holds.
+    // Implementations synchronize the two.
+    class PriceStore {
+    public:
+        using TimePoint = std::chrono::system_clock::time_point;
+
+        virtual ~PriceStore() = default;
+
+        // Persist a batch in order. Returns how many ticks were stored.
+        virtual size_t append(const std::vector<Tick>& ticks) = 0;
+
+        // Stored prices for `symbol` with from <= timestamp < to, oldest first
+        virtual std::vector<PriceHistoryCache::Point> history(SymbolId symbol, TimePoint from, TimePoint to) = 0;
+    };
+
+    // One row per tick in the price_ticks table of the service database,
+    // on a tuned connection of its own with the insert and range query
+    // prepared once. The table and its (symbol, timestamp_ms) index belong
+    // to this service, like price_bars. Each append() batch is one
+    // transaction and holds the database mutex; reads only need the
+    // connection.
+    class SqlitePriceStore : public PriceStore {
+    private:
+        const SymbolTable& symbol_table;
+        DatabaseMutex& database_mutex;
+        std::mutex mutex;  // Serializes use of the connection
+        SqliteConnection connection;
+        LogRateLimiter save_error_log;  // A failing database fails every row
+
+    public:
+        SqlitePriceStore(const std::string& path, const DatabaseTuningConfig& tuning, DatabaseMutex& database_mutex,
+            const SymbolTable& symbol_table);
+
+        size_t append(const std::vector<Tick>& ticks) override;
+        std::vector<PriceHistoryCache::Point> history(SymbolId symbol, TimePoint from, TimePoint to) override;
+    };
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "BarStore.h"
+#include "LatencyHistogram.h"
+#include "LogRateLimiter.h"
+#include "PriceStore.h"
+#include "Tick.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace StockTracker {
+
+    // What enqueue() does when the queue is already at capacity
+    enum class OverflowPolicy {
+        Block,       // Wait for the writer to make room (backpressure on the tick path)
+        DropNewest,  // Discard the incoming quote
+        DropOldest   // Discard the oldest queued quote to make room
+    };
+
+    struct PriceWriterConfig {
+        size_t queue_capacity{ 65536 };
+        size_t max_batch_size{ 512 };                  // Flush as soon as this many quotes are queued
+        std::chrono::milliseconds flush_interval{ 250 }; // ...or after this long, whichever comes first
+        OverflowPolicy overflow_policy{ OverflowPolicy::DropOldest };
+    };
+
+    struct PriceWriterStats {
+        uint64_t enqueued{ 0 };
+        uint64_t written{ 0 };
+        uint64_t dropped{ 0 };
+        uint64_t batches{ 0 };
+        uint64_t bars_written{ 0 };
+        size_t queue_depth{ 0 };
+        size_t max_queue_depth{ 0 };
+        double last_flush_ms{ 0.0 };
+        double max_flush_ms{ 0.0 };
+        LatencySummary flush;  // Duration of each batch write
+    };
+
+    // Moves price persistence off the publishing threads. Ticks are pushed
+    // into a bounded queue and a background thread drains them into the
+    // price store in batches. Closed rollup bars travel the same way into
+    // the bar store.
+    class PriceWriter {
+    private:
+        PriceStore& price_store;
+        BarStore& bar_store;
+        const PriceWriterConfig config;
+
+        mutable std::mutex queue_mutex;
+        std::condition_variable queue_ready;  // Writer waits on this for work
+        std::condition_variable queue_space;  // Producers wait on this under OverflowPolicy::Block
+        // Fixed-size circular FIFO, allocated once, so enqueue never touches the heap
+        std::vector<Tick> ring;
+        size_t ring_head{ 0 };  // Oldest queued tick
+        size_t queued{ 0 };
+        std::vector<RollupBar> pending_bars;  // Low volume, flushed with every batch
+        bool stopping{ false };
+
+        // Counters (readable from any thread)
+        std::atomic<uint64_t> enqueued{ 0 };
+        std::atomic<uint64_t> written{ 0 };
+        std::atomic<uint64_t> dropped{ 0 };
+        std::atomic<uint64_t> batches{ 0 };
+        std::atomic<uint64_t> bars_written{ 0 };
+        std::atomic<size_t> max_queue_depth{ 0 };
+        std::atomic<double> last_flush_ms{ 0.0 };
+        std::atomic<double> max_flush_ms{ 0.0 };
+        LatencyHistogram flush_latency;
+
+        LogRateLimiter save_error_log;  // A failing store fails every batch
+
+        std::thread writer_thread;
+
+        void writerLoop();
+        void writeBatch(std::vector<Tick>& batch);
+        void writeBars(const std::vector<RollupBar>& bars);
+
+    public:
+        PriceWriter(PriceStore& price_store, BarStore& bar_store,
+            const PriceWriterConfig& config = PriceWriterConfig{});
+        ~PriceWriter();
+
+        // Queue a tick for persistence. Returns false if it was dropped.
+        bool enqueue(const Tick& tick);
+
+        // Queue a closed bar; never dropped
+        void enqueue(const RollupBar& bar);
+
+        // Drain whatever is queued and stop the writer thread
+        void stop();
+
+        PriceWriterStats stats() const;
+
+        PriceWriter(const PriceWriter&) = delete;
+        PriceWriter& operator=(const PriceWriter&) = delete;
+    };
+}
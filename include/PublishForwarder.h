@@ -0,0 +1,58 @@
+#pragma once
+#include <zmq.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace StockTracker {
+
+    struct PublishForwarderConfig {
+        // Run the forwarder in this instance. One instance of a partitioned
+        // deployment does; the others bind only their own endpoints.
+        bool enabled{ false };
+        // Where CLIs and feed consumers connect, as for a single instance.
+        // The members' own endpoints must differ from these.
+        std::string publish_frontend{ "tcp://*:5556" };
+        std::string feed_frontend{ "tcp://*:5558" };
+    };
+
+    // Presents several DataService publishers as one. Each route binds an
+    // XPUB frontend for subscribers and connects an XSUB to every backend
+    // publisher, so subscribers receive the union of what the members send
+    // and their subscriptions are passed upstream (the quote feed still only
+    // encodes what someone is listening to). This is zmq_proxy, run in a
+    // poll loop on our own thread so stop() is noticed promptly.
+    class PublishForwarder {
+    public:
+        struct Route {
+            std::string frontend;
+            std::vector<std::string> backends;
+        };
+
+    private:
+        struct Link {
+            zmq::socket_t frontend;  // XPUB
+            zmq::socket_t backend;   // XSUB
+        };
+
+        zmq::context_t context;
+        std::vector<std::unique_ptr<Link>> links;
+        std::atomic<bool> running{ true };
+        std::thread forward_thread;
+
+        void forward();
+        static void relay(zmq::socket_t& from, zmq::socket_t& to);
+
+    public:
+        // Routes with no backends are skipped
+        explicit PublishForwarder(const std::vector<Route>& routes);
+        ~PublishForwarder();
+
+        void stop();
+
+        PublishForwarder(const PublishForwarder&) = delete;
+        PublishForwarder& operator=(const PublishForwarder&) = delete;
+    };
+}
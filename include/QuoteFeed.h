@@ -0,0 +1,137 @@
+#pragma once
+#include "FxRateCache.h"
+#include "QuoteWire.h"
+#include "SymbolTable.h"
+#include "Tick.h"
+#include <spdlog/fmt/fmt.h>
+#include <zmq.hpp>
+#include <chrono>
+#include <optional>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace StockTracker {
+
+    struct QuoteFeedConfig {
+        bool enabled{ false };  // Opt-in: a new listening port
+        std::string endpoint{ "tcp://*:5558" };
+        int send_high_water_mark{ 100000 };
+        // How long quotes may wait in a batch (QB/, BB/ topics) before it is
+        // sent. Zero sends each batch at the end of the update cycle that
+        // filled it; larger values trade latency for fewer, bigger frames.
+        std::chrono::milliseconds batch_window{ 0 };
+    };
+
+    // Topic-addressed quote stream published next to the legacy CLI socket.
+    // Every message is two frames, [topic][quote], with the topic laid out
+    // as described in QuoteWire.h, so consumers select format, currency and
+    // symbols with ordinary ZeroMQ prefix subscriptions and unwanted quotes
+    // are dropped inside the PUB socket. The socket is an XPUB, which also
+    // tells us what anyone is subscribed to: a USD tick is only converted
+    // and encoded for the (format, currency, symbol) combinations that have
+    // a listener.
+    //
+    // Sends never block. With ZMQ_XPUB_NODROP a message that meets a full
+    // subscriber pipe is refused instead of silently dropped, so a lost
+    // dictionary entry is known and retried.
+    //
+    // Not thread-safe; owned by the update thread after construction.
+    class QuoteFeed {
+    private:
+        // Which symbols of a currency have listeners in one format
+        struct Interest {
+            bool all_symbols{ false };
+            std::unordered_set<SymbolId> symbols;
+
+            bool wants(SymbolId symbol) const {
+                return all_symbols || symbols.count(symbol) != 0;
+            }
+        };
+
+        struct CurrencyInterest {
+            Interest text;
+            Interest binary;
+            bool text_batch{ false };
+            bool binary_batch{ false };
+        };
+
+        // Quotes waiting to go out as one batch frame per currency
+        struct PendingBatch {
+            fmt::memory_buffer text;
+            fmt::memory_buffer binary;
+        };
+
+        FxRateCache& fx_rates;
+        const SymbolTable& symbol_table;
+        const QuoteFeedConfig config;
+
+        zmq::context_t context;
+        zmq::socket_t socket;
+
+        std::unordered_set<std::string> subscribed_topics;
+
+        // Active currencies, their listeners and their rates for the current
+        // cycle (parallel arrays)
+        std::vector<std::string> currencies;
+        std::vector<CurrencyInterest> interests;
+        std::vector<PendingBatch> batches;
+        std::vector<double> rates;
+        std::vector<double> prices;  // Scratch for the fan-out
+
+        // This member's tag in binary symbol ids (see QuoteWire::wireSymbolId)
+        const uint32_t member;
+
+        // Dictionary state by symbol id; announced_ids lists every id that
+        // has left Unannounced, for full resends
+        enum class Announced : uint8_t { No, Sent, Retry };
+        std::vector<Announced> announced;
+        std::vector<SymbolId> announced_ids;
+        bool resend_dictionary{ false };
+
+        fmt::memory_buffer topic;
+        fmt::memory_buffer payload;
+        uint64_t published{ 0 };
+        uint64_t batches_sent{ 0 };
+
+        // Set while any batch holds quotes
+        std::optional<std::chrono::steady_clock::time_point> batch_started;
+
+        bool readSubscriptions();
+        void rebuildCurrencies();
+
+        bool announce(SymbolId id, const std::string& symbol);
+        bool sendDictionaryEntry(SymbolId id, const std::string& symbol);
+
+        void sendText(const Tick& tick, const std::string& symbol, const std::string& currency, double price);
+        void sendBinary(const Tick& tick, const std::string& symbol, const std::string& currency, double price);
+        void appendToBatch(size_t index, const Tick& tick, const std::string& symbol, double price);
+        void flushBatches();
+
+    public:
+        // `member` is this instance's index in the partition, 0 when it is
+        // not partitioned. Throws std::runtime_error past QuoteWire::MaxMembers.
+        QuoteFeed(FxRateCache& fx_rates, const SymbolTable& symbol_table,
+            const QuoteFeedConfig& config = QuoteFeedConfig{}, uint32_t member = 0);
+
+        // Process subscription changes and snapshot the rates for the active
+        // currencies. Call once per update cycle, before publish().
+        void beginCycle();
+
+        // Publish a USD tick in every active currency and format
+        void publish(const Tick& tick);
+
+        // Send batches whose window has elapsed. Call once per update cycle,
+        // after the last publish().
+        void endCycle();
+
+        // When the oldest pending batch must be sent, if any is pending
+        std::optional<std::chrono::steady_clock::time_point> flushDeadline() const;
+
+        const std::vector<std::string>& activeCurrencies() const { return currencies; }
+        uint64_t publishedCount() const { return published; }
+        uint64_t batchesSent() const { return batches_sent; }
+    };
+}
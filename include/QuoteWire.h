@@ -0,0 +1,152 @@
+#pragma once
+#include <StockTracker/Types.h>
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace StockTracker::QuoteWire {
+
+    // Quote encodings on the topic feed. Subscribers choose one by the topic
+    // prefix they subscribe to, so text and binary consumers share a socket
+    // and the service only encodes formats somebody is listening for.
+    enum class Format { Text, Binary };
+
+    // Quote topics are "<PREFIX><CURRENCY>/<SYMBOL>/" with prefix "Q/" for
+    // text and "B/" for binary. The trailing separator keeps prefix matching
+    // exact: "Q/USD/" is every USD quote, "Q/USD/AAPL/" is only AAPL (and
+    // does not also match "AAPLX").
+    constexpr std::string_view QuoteTopicPrefix = "Q/";
+    constexpr std::string_view BinaryQuoteTopicPrefix = "B/";
+
+    // Quote batches are "<PREFIX><CURRENCY>/" with prefix "QB/" for text and
+    // "BB/" for binary. One frame carries every quote produced for that
+    // currency in a publish window: text records separated by '\n', or
+    // back-to-back binary records. Batches cannot be filtered by symbol.
+    constexpr std::string_view QuoteBatchTopicPrefix = "QB/";
+    constexpr std::string_view BinaryQuoteBatchTopicPrefix = "BB/";
+
+    // Symbol dictionary for the binary format: topic "D/", payload is a
+    // little-endian uint32 symbol id followed by the symbol characters.
+    // Each id is announced before its first binary quote, an entry that
+    // could not be sent is retried with the symbol's next binary quote, and
+    // the full table is resent whenever a new binary subscription appears.
+    constexpr std::string_view DictionaryTopic = "D/";
+
+    // Binary symbol ids carry the publishing member's index in the
+    // partition (0 for a single instance) in the top 8 bits and that
+    // member's own symbol id in the low 24. Every member agrees on the
+    // indexes, so feeds merged by a PublishForwarder never use one id for
+    // two symbols.
+    constexpr uint32_t MemberIdShift = 24;
+    constexpr uint32_t MaxMembers = 1u << (32 - MemberIdShift);
+    constexpr uint32_t LocalIdMask = (1u << MemberIdShift) - 1;
+
+    constexpr uint32_t wireSymbolId(uint32_t member, uint32_t local_id) {
+        return (member << MemberIdShift) | local_id;
+    }
+
+    constexpr std::string_view topicPrefix(Format format) {
+        return format == Format::Binary ? BinaryQuoteTopicPrefix : QuoteTopicPrefix;
+    }
+
+    constexpr std::string_view batchTopicPrefix(Format format) {
+        return format == Format::Binary ? BinaryQuoteBatchTopicPrefix : QuoteBatchTopicPrefix;
+    }
+
+    inline void quoteTopic(fmt::memory_buffer& out, Format format, std::string_view currency, std::string_view symbol) {
+        fmt::format_to(std::back_inserter(out), "{}{}/{}/", topicPrefix(format), currency, symbol);
+    }
+
+    inline void batchTopic(fmt::memory_buffer& out, Format format, std::string_view currency) {
+        fmt::format_to(std::back_inserter(out), "{}{}/", batchTopicPrefix(format), currency);
+    }
+
+    // Text payload: one space-separated record
+    //   SYMBOL PRICE CHANGE_PERCENT TIMESTAMP_MS CURRENCY
+    // with the timestamp in milliseconds since the Unix epoch.
+    inline void encodeText(fmt::memory_buffer& out, std::string_view symbol, double price,
+        double change_percent, std::chrono::system_clock::time_point timestamp, std::string_view currency) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+        fmt::format_to(std::back_inserter(out), "{} {:.6f} {:.6f} {} {}",
+            symbol, price, change_percent, ms, currency);
+    }
+
+    // Binary payload: fixed 32-byte little-endian record
+    //   0  uint32  symbol id (see DictionaryTopic and wireSymbolId)
+    //   4  char[4] currency code, NUL padded
+    //   8  int64   price in millionths of the currency unit
+    //   16 int64   change percent in millionths of a percent
+    //   24 int64   timestamp, microseconds since the Unix epoch
+    // Small enough for ZeroMQ to store inline in the message, so encoding
+    // and sending a quote does not touch the heap.
+    constexpr size_t BinaryQuoteSize = 32;
+    constexpr double FixedPointScale = 1e6;
+
+    struct BinaryQuote {
+        uint32_t symbol_id;
+        char currency[4];
+        int64_t price_micros;
+        int64_t change_percent_micros;
+        int64_t timestamp_us;
+    };
+
+    namespace detail {
+        template <typename T>
+        inline void putLE(unsigned char* out, T value) {
+            auto bits = static_cast<std::make_unsigned_t<T>>(value);
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                out[i] = static_cast<unsigned char>(bits >> (8 * i));
+            }
+        }
+
+        template <typename T>
+        inline T getLE(const unsigned char* in) {
+            std::make_unsigned_t<T> bits = 0;
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                bits |= static_cast<std::make_unsigned_t<T>>(in[i]) << (8 * i);
+            }
+            return static_cast<T>(bits);
+        }
+    }
+
+    inline void encodeBinary(void* out, uint32_t symbol_id, std::string_view currency, double price,
+        double change_percent, std::chrono::system_clock::time_point timestamp) {
+        auto* bytes = static_cast<unsigned char*>(out);
+        detail::putLE<uint32_t>(bytes, symbol_id);
+
+        std::memset(bytes + 4, 0, 4);
+        std::memcpy(bytes + 4, currency.data(), std::min<size_t>(currency.size(), 4));
+
+        detail::putLE<int64_t>(bytes + 8, std::llround(price * FixedPointScale));
+        detail::putLE<int64_t>(bytes + 16, std::llround(change_percent * FixedPointScale));
+        detail::putLE<int64_t>(bytes + 24, std::chrono::duration_cast<std::chrono::microseconds>(
+            timestamp.time_since_epoch()).count());
+    }
+
+    inline BinaryQuote decodeBinary(const void* in) {
+        const auto* bytes = static_cast<const unsigned char*>(in);
+        BinaryQuote quote{};
+        quote.symbol_id = detail::getLE<uint32_t>(bytes);
+        std::memcpy(quote.currency, bytes + 4, 4);
+        quote.price_micros = detail::getLE<int64_t>(bytes + 8);
+        quote.change_percent_micros = detail::getLE<int64_t>(bytes + 16);
+        quote.timestamp_us = detail::getLE<int64_t>(bytes + 24);
+        return quote;
+    }
+
+    // Unpack a binary batch frame; trailing bytes that do not form a whole
+    // record are ignored
+    inline void decodeBinaryBatch(const void* in, size_t size, std::vector<BinaryQuote>& out) {
+        const auto* bytes = static_cast<const unsigned char*>(in);
+        for (size_t offset = 0; offset + BinaryQuoteSize <= size; offset += BinaryQuoteSize) {
+            out.push_back(decodeBinary(bytes + offset));
+        }
+    }
+}
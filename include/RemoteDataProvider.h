@@ -0,0 +1,95 @@
+#pragma once
+#include "IStockDataProvider.h"
+#include <zmq.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace StockTracker {
+
+    struct RemoteProviderConfig {
+        std::string endpoint{ "tcp://localhost:5570" };  // Upstream quote gateway (ROUTER)
+        std::vector<std::string> symbols;                // Empty = ask the gateway at startup
+        std::chrono::milliseconds request_timeout{ 2000 };
+        // Gateway PUB endpoint streaming "<SYMBOL> <PRICE> <CHANGE_PERCENT>
+        // <TIMESTAMP_MS>" frames. Set to enable push mode.
+        std::string stream_endpoint;
+    };
+
+    // Quotes from an upstream market data gateway over one persistent
+    // DEALER connection. Requests are pipelined: every caller's request is
+    // sent as soon as it is submitted and replies are matched back by id,
+    // so concurrent shards never wait on each other's round trips.
+    //
+    // Gateway protocol, one text frame each way:
+    //   TICKS <ID> <SYMBOL>...  ->  TICKS <ID>\n<SYMBOL> <PRICE> <CHANGE_PERCENT> <TIMESTAMP_MS>\n...
+    //   SYMBOLS <ID>            ->  SYMBOLS <ID>\n<SYMBOL>\n...
+    //   (either)                ->  ERROR <ID> <REASON>
+    class RemoteDataProvider : public IStockDataProvider {
+    private:
+        // Reply body, or nullptr if the request failed or timed out
+        using ReplyHandler = std::function<void(const std::string* body)>;
+
+        struct Request {
+            uint64_t id;
+            std::string payload;
+            ReplyHandler done;
+            std::chrono::steady_clock::time_point deadline;
+        };
+
+        SymbolTable& symbol_table;
+        const RemoteProviderConfig config;
+
+        std::vector<uint8_t> known;  // Indexed by SymbolId
+        std::vector<SymbolId> available;
+
+        zmq::context_t context;
+        zmq::socket_t dealer;     // I/O thread only
+        zmq::socket_t wake_pull;  // I/O thread only
+        zmq::socket_t wake_push;  // Guarded by submit_mutex
+        zmq::socket_t stream_sub; // I/O thread only; connected if stream_endpoint is set
+        std::atomic<TickStream*> stream{ nullptr };
+
+        std::mutex submit_mutex;
+        std::deque<Request> submitted;
+        std::unordered_map<uint64_t, Request> in_flight;  // I/O thread only
+        std::atomic<uint64_t> next_id{ 1 };
+        std::atomic<bool> running{ true };
+        std::thread io_thread;
+
+        void submit(const std::string& verb, const std::string& args, ReplyHandler done);
+        void ioLoop();
+        void sendSubmitted();
+        void handleReply(const std::string& reply);
+        void expire(std::chrono::steady_clock::time_point now);
+
+        void addSymbol(const std::string& symbol);
+        void loadSymbols();
+        std::vector<Tick> parseTicks(const std::string& body) const;
+        void receiveStream();
+
+    public:
+        RemoteDataProvider(SymbolTable& symbol_table, const RemoteProviderConfig& config);
+        ~RemoteDataProvider() override;
+
+        StockQuote generateQuote(const std::string& symbol) override;
+        bool isValidSymbol(const std::string& symbol) const override;
+        bool isValidSymbol(SymbolId id) const override;
+        std::vector<std::string> getAvailableSymbols() const override;
+
+        // Blocks for one round trip; ids the gateway could not quote are missing
+        void generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) override;
+        void requestTicks(std::vector<SymbolId> ids, TickHandler done) override;
+
+        // Forwards the gateway stream from the I/O thread, if one is configured
+        bool startStreaming(TickStream& stream) override;
+
+        RemoteDataProvider(const RemoteDataProvider&) = delete;
+        RemoteDataProvider& operator=(const RemoteDataProvider&) = delete;
+    };
+}
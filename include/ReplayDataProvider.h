@@ -0,0 +1,72 @@
+#pragma once
+#include "IStockDataProvider.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace StockTracker {
+
+    struct ReplayProviderConfig {
+        // Recorded ticks, one "<SYMBOL> <PRICE> <CHANGE_PERCENT> <TIMESTAMP_MS>"
+        // line each in timestamp order (the remote gateway's stream format)
+        std::string path;
+        // 1 = recorded pace, 10 = ten times faster, 0 = as fast as the
+        // update thread drains them
+        double speed{ 1.0 };
+        bool loop{ false };               // Start over at the end of the file
+        bool rebase_timestamps{ true };   // Stamp ticks with the replay time, not the recorded one
+    };
+
+    // Plays a recorded tick file through the service's streaming path, so
+    // every tick is published and persisted exactly as live data would be.
+    // Symbols are collected by one pass over the file at construction.
+    class ReplayDataProvider : public IStockDataProvider {
+    private:
+        SymbolTable& symbol_table;
+        const ReplayProviderConfig config;
+
+        std::vector<uint8_t> known;  // Indexed by SymbolId
+        std::vector<SymbolId> available;
+
+        mutable std::mutex last_mutex;
+        std::vector<Tick> last;  // Latest replayed tick per symbol (price 0 until seen)
+
+        std::mutex stop_mutex;
+        std::condition_variable stop_signal;  // Cuts pacing sleeps short on shutdown
+        std::atomic<bool> running{ true };
+        std::atomic<uint64_t> replayed{ 0 };
+        std::thread feed_thread;
+
+        // Parse one record; false for blank or malformed lines
+        static bool parseLine(const std::string& line, std::string& symbol, Tick& tick);
+        void scanSymbols();
+        void replayLoop(TickStream& stream);
+        // One pass over the file; false if replay should stop
+        bool replayFile(std::ifstream& in, TickStream& stream);
+        bool sleepUntil(std::chrono::steady_clock::time_point when);
+
+    public:
+        ReplayDataProvider(SymbolTable& symbol_table, const ReplayProviderConfig& config);
+        ~ReplayDataProvider() override;
+
+        // Latest replayed value; throws until the symbol has been replayed
+        StockQuote generateQuote(const std::string& symbol) override;
+        bool isValidSymbol(const std::string& symbol) const override;
+        bool isValidSymbol(SymbolId id) const override;
+        std::vector<std::string> getAvailableSymbols() const override;
+
+        // Latest replayed values; symbols not replayed yet are missing
+        void generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) override;
+
+        // Starts the feed thread
+        bool startStreaming(TickStream& stream) override;
+
+        ReplayDataProvider(const ReplayDataProvider&) = delete;
+        ReplayDataProvider& operator=(const ReplayDataProvider&) = delete;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <zmq.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace StockTracker {
+
+    struct RequestServerConfig {
+        bool enabled{ false };  // Opt-in: a new listening port
+        std::string endpoint{ "tcp://*:5559" };
+    };
+
+    // Request/reply endpoint for queries that do not fit the CLI Message
+    // protocol. A ROUTER socket serves REQ and DEALER clients alike: each
+    // request is one text frame and gets one text reply frame produced by
+    // the handler, which runs on this server's own thread.
+    class RequestServer {
+    public:
+        using Handler = std::function<std::string(const std::string& request)>;
+
+    private:
+        const RequestServerConfig config;
+        Handler handler;
+
+        zmq::context_t context;
+        zmq::socket_t socket;
+        std::atomic<bool> running{ true };
+        std::thread server_thread;
+
+        void serve();
+        void handleOne();
+
+    public:
+        RequestServer(const RequestServerConfig& config, Handler handler);
+        ~RequestServer();
+
+        void stop();
+
+        RequestServer(const RequestServer&) = delete;
+        RequestServer& operator=(const RequestServer&) = delete;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "DatabaseMutex.h"
+#include "SqliteConnection.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace StockTracker {
+
+    struct RetentionConfig {
+        bool enabled{ false };  // Opt-in: by default every price is kept, as before
+        std::chrono::hours raw_retention{ 24 };       // Raw ticks older than this are deleted
+        std::chrono::hours bar_retention{ 0 };        // Rollup bars likewise; 0 keeps them forever
+        std::chrono::minutes sweep_interval{ 5 };
+        size_t delete_batch_size{ 1000 };             // Rows per DELETE, each its own short transaction
+        std::chrono::milliseconds batch_pause{ 20 };  // Gap between batches so writers get the lock
+        size_t vacuum_pages{ 1024 };                  // Pages returned per sweep (incremental auto_vacuum only)
+        // Switch a database created without auto_vacuum to INCREMENTAL. This
+        // takes a one-off full VACUUM at startup.
+        bool convert_auto_vacuum{ false };
+    };
+
+    struct RetentionStats {
+        uint64_t sweeps{ 0 };
+        uint64_t ticks_deleted{ 0 };
+        uint64_t bars_deleted{ 0 };
+        uint64_t pages_vacuumed{ 0 };
+    };
+
+    // Background sweeper that keeps the database bounded: raw ticks are
+    // kept for raw_retention, after which only rollup bars remain. Only the
+    // tables this service owns are swept: price_ticks (SqlitePriceStore)
+    // and price_bars (BarStore). Deletes run oldest-first in small batches
+    // on a connection of their own, so the price writer is never held up
+    // for more than one batch. Each batch holds the database mutex.
+    class RetentionManager {
+    private:
+        const RetentionConfig config;
+        DatabaseMutex& database_mutex;
+        SqliteConnection connection;  // Used only by the sweeper thread
+        bool incremental_vacuum{ false };
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool stopping{ false };
+
+        std::atomic<uint64_t> sweeps{ 0 };
+        std::atomic<uint64_t> ticks_deleted{ 0 };
+        std::atomic<uint64_t> bars_deleted{ 0 };
+        std::atomic<uint64_t> pages_vacuumed{ 0 };
+
+        std::thread sweeper_thread;
+
+        void sweepLoop();
+        void sweep();
+        uint64_t deleteTicks(std::chrono::system_clock::time_point cutoff);
+        uint64_t deleteBars(std::chrono::system_clock::time_point cutoff);
+        void vacuum();
+
+        // Sleep between batches; returns false once stopping
+        bool pause();
+
+    public:
+        RetentionManager(const std::string& path, const DatabaseTuningConfig& tuning, DatabaseMutex& database_mutex,
+            const RetentionConfig& config = RetentionConfig{});
+        ~RetentionManager();
+
+        void stop();
+
+        RetentionStats stats() const;
+
+        RetentionManager(const RetentionManager&) = delete;
+        RetentionManager& operator=(const RetentionManager&) = delete;
+    };
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "PriceHistoryQuery.h"
+#include "SymbolTable.h"
+#include <chrono>
+
+namespace StockTracker {
+
+    // One aggregated bar for a symbol at a fixed resolution. The mean is
+    // tick-weighted and the volatility is the standard deviation of the
+    // tick-to-tick returns inside the bar.
+    struct RollupBar {
+        SymbolId symbol;
+        BarResolution resolution;
+        PriceBar ohlc;
+        double mean;
+        double volatility;
+    };
+}
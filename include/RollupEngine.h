@@ -0,0 +1,74 @@
+#pragma once
+#include "Rollup.h"
+#include "Tick.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace StockTracker {
+
+    struct RollupConfig {
+        bool enabled{ true };
+        std::vector<BarResolution> resolutions{ BarResolution::Minute, BarResolution::Hour };
+        size_t retained_bars{ 120 };  // Closed bars kept in memory per symbol and resolution
+    };
+
+    // Maintains the open bar for every symbol at each configured resolution,
+    // updated in O(1) per tick from the update loop. When a tick lands in a
+    // new bucket the previous bar is closed, kept in a short in-memory
+    // window and handed to the sink for persistence.
+    class RollupEngine {
+    public:
+        using Sink = std::function<void(const RollupBar&)>;
+
+    private:
+        // Running state of one open bar: a running price mean, and Welford
+        // updates for the mean and variance of tick-to-tick returns
+        struct Accumulator {
+            bool open{ false };
+            PriceBar ohlc{};
+            double mean{ 0.0 };
+            uint32_t returns{ 0 };
+            double return_mean{ 0.0 };
+            double return_m2{ 0.0 };
+        };
+
+        struct Series {
+            std::vector<Accumulator> current;      // Indexed by SymbolId
+            std::vector<std::deque<RollupBar>> closed; // Indexed by SymbolId, oldest first
+        };
+
+        const RollupConfig config;
+        const Sink sink;
+
+        mutable std::mutex mutex;
+        std::vector<Series> series;  // Parallel to config.resolutions
+        std::chrono::system_clock::time_point next_expiry{ std::chrono::system_clock::time_point::max() };
+
+        std::optional<size_t> indexOf(BarResolution resolution) const;
+        void add(size_t index, const Tick& tick);
+        void close(size_t index, SymbolId symbol);
+        static RollupBar finish(const Accumulator& acc, SymbolId symbol, BarResolution resolution);
+
+    public:
+        RollupEngine(const RollupConfig& config, Sink sink);
+
+        // Fold ticks into the open bars (update thread)
+        void update(const std::vector<Tick>& ticks);
+
+        // Close every open bar whose bucket ended at or before `now`, so quiet
+        // or unsubscribed symbols still get their last bar persisted
+        void closeExpired(std::chrono::system_clock::time_point now);
+
+        bool tracks(BarResolution resolution) const { return indexOf(resolution).has_value(); }
+
+        // The latest `limit` bars still in memory, oldest first. The open bar,
+        // if there is one, is the last and counts toward the limit.
+        std::vector<RollupBar> recent(SymbolId symbol, BarResolution resolution, size_t limit,
+            bool include_open = true) const;
+    };
+}
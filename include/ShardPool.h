@@ -0,0 +1,57 @@
+#pragma once
+#include "SymbolTable.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace StockTracker {
+
+    struct ShardPoolConfig {
+        size_t shards{ 0 };  // 0 = one per hardware thread
+    };
+
+    // Fork/join pool that splits each cycle's due symbols into shards by
+    // id % size() and runs the job for every non-empty shard in parallel.
+    // Shard 0 runs on the calling thread; the rest have a worker each.
+    class ShardPool {
+    public:
+        using Job = std::function<void(size_t shard, const std::vector<SymbolId>& ids)>;
+
+        // Shard count a config resolves to
+        static size_t resolveCount(const ShardPoolConfig& config);
+
+    private:
+        struct Worker {
+            std::vector<SymbolId> ids;
+            bool has_work{ false };
+            std::thread thread;
+        };
+
+        const Job job;
+        std::vector<Worker> workers;  // Indexed by shard
+
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+        size_t outstanding{ 0 };
+        bool stopping{ false };
+
+        void workerLoop(size_t shard);
+
+    public:
+        ShardPool(const ShardPoolConfig& config, Job job);
+        ~ShardPool();
+
+        size_t size() const { return workers.size(); }
+
+        // Run the job over `ids` and return once every shard has finished
+        void run(const std::vector<SymbolId>& ids);
+
+        void stop();
+
+        ShardPool(const ShardPool&) = delete;
+        ShardPool& operator=(const ShardPool&) = delete;
+    };
+}
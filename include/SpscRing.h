@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace StockTracker {
+
+    // Bounded lock-free ring for exactly one producer thread and one
+    // consumer thread. Capacity is rounded up to a power of two; indices
+    // grow without wrapping and are masked on access.
+    template <typename T>
+    class SpscRing {
+    private:
+        std::vector<T> slots;
+        const size_t mask;
+
+        // Producer and consumer indices on separate cache lines
+        alignas(64) std::atomic<size_t> head{ 0 };  // Next slot to write
+        alignas(64) std::atomic<size_t> tail{ 0 };  // Next slot to read
+
+        static size_t roundUp(size_t capacity) {
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            return size;
+        }
+
+    public:
+        explicit SpscRing(size_t capacity)
+            : slots(roundUp(capacity))
+            , mask(slots.size() - 1)
+        {
+        }
+
+        size_t capacity() const { return slots.size(); }
+
+        // Producer only. Returns false if the ring is full.
+        bool tryPush(const T& value) {
+            const size_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) == slots.size()) {
+                return false;
+            }
+            slots[h & mask] = value;
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only. Returns false if the ring is empty.
+        bool tryPop(T& value) {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            if (t == head.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = slots[t & mask];
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool empty() const {
+            return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+        }
+    };
+}
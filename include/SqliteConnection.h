@@ -0,0 +1,53 @@
+#pragma once
+#include <sqlite3.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace StockTracker {
+
+    // Performance profile for the service database. The journal mode and
+    // indexes belong to the database file, so they also take effect for the
+    // DatabaseService connection; the rest are per connection.
+    struct DatabaseTuningConfig {
+        std::string journal_mode{ "WAL" };
+        std::string synchronous{ "NORMAL" };         // OFF, NORMAL, FULL or EXTRA
+        int64_t mmap_size{ 256LL * 1024 * 1024 };    // Bytes, 0 disables memory-mapped I/O
+        int64_t cache_size_kib{ 64 * 1024 };         // Page cache per connection
+        std::chrono::milliseconds busy_timeout{ 5000 };
+        bool index_price_history{ true };            // (symbol, timestamp_ms) index on price_ticks
+    };
+
+    // One SQLite connection opened with DatabaseTuningConfig, with every
+    // statement prepared once and reused. Not thread-safe; callers
+    // serialize access.
+    class SqliteConnection {
+    private:
+        sqlite3* db{ nullptr };
+        std::unordered_map<std::string, sqlite3_stmt*> statements;
+
+        void applyTuning(const DatabaseTuningConfig& tuning);
+        // Finalizes every cached statement, then closes the handle
+        void close();
+
+    public:
+        SqliteConnection(const std::string& path, const DatabaseTuningConfig& tuning);
+        ~SqliteConnection();
+
+        void exec(const std::string& sql);
+        bool hasTable(const std::string& name);
+
+        // Cached prepared statement, reset and with bindings cleared
+        sqlite3_stmt* statement(const std::string& sql);
+
+        // Throws with the connection's last error message
+        [[noreturn]] void fail(const std::string& what) const;
+
+        sqlite3* handle() const { return db; }
+
+        SqliteConnection(const SqliteConnection&) = delete;
+        SqliteConnection& operator=(const SqliteConnection&) = delete;
+    };
+}
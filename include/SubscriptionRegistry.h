@@ -0,0 +1,44 @@
+#pragma once
+#include "SymbolTable.h"
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace StockTracker {
+
+    // Set of subscribed symbols shared between the command thread (writer)
+    // and the update thread (reader). Writers copy the current set, modify
+    // the copy and publish it with an atomic pointer swap; readers grab an
+    // immutable snapshot they can iterate for as long as they like without
+    // holding any lock. Old versions are freed when the last reader drops them.
+    class SubscriptionRegistry {
+    public:
+        using Set = std::unordered_set<SymbolId>;
+        using Snapshot = std::shared_ptr<const Set>;
+
+    private:
+        std::mutex write_mutex;  // Serializes writers only
+        Snapshot current;
+
+        void publish(Snapshot next);
+
+    public:
+        SubscriptionRegistry();
+
+        Snapshot snapshot() const;
+
+        bool contains(SymbolId symbol) const;
+        size_t size() const;
+
+        // Returns true if the symbol was not already subscribed
+        bool add(SymbolId symbol);
+        // Returns true if the symbol was subscribed
+        bool remove(SymbolId symbol);
+
+        // Bulk variants publish a single new version; they return the
+        // symbols that were actually added/removed
+        std::vector<SymbolId> add(const std::vector<SymbolId>& symbols);
+        std::vector<SymbolId> remove(const std::vector<SymbolId>& symbols);
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "StockTracker/DatabaseService.h"
+#include "DatabaseMutex.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace StockTracker {
+
+    struct SubscriptionWriterConfig {
+        // Changes are held this long after the first one arrives, so a
+        // restored watchlist becomes a single write
+        std::chrono::milliseconds flush_delay{ 100 };
+    };
+
+    struct SubscriptionWriterStats {
+        uint64_t changes{ 0 };    // save()/remove() calls
+        uint64_t coalesced{ 0 };  // Changes superseded by a later one for the same symbol before a flush
+        uint64_t flushes{ 0 };
+    };
+
+    // Persists subscription changes off the command thread. Pending changes
+    // are kept per symbol (the latest wins), so a burst of changes becomes
+    // one saveSubscription()/removeSubscription() call per symbol, made
+    // together under the database mutex.
+    class SubscriptionWriter {
+    private:
+        DatabaseService& db_service;
+        DatabaseMutex& database_mutex;
+        const SubscriptionWriterConfig config;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::unordered_map<std::string, bool> pending;  // Symbol -> subscribed
+        bool stopping{ false };
+
+        std::atomic<uint64_t> changes{ 0 };
+        std::atomic<uint64_t> coalesced{ 0 };
+        std::atomic<uint64_t> flushes{ 0 };
+
+        std::thread writer_thread;
+
+        void queue(const std::string& symbol, bool subscribed);
+        void writerLoop();
+        void write(const std::unordered_map<std::string, bool>& batch);
+
+    public:
+        SubscriptionWriter(DatabaseService& db_service, DatabaseMutex& database_mutex,
+            const SubscriptionWriterConfig& config = SubscriptionWriterConfig{});
+        ~SubscriptionWriter();
+
+        void save(const std::string& symbol) { queue(symbol, true); }
+        void remove(const std::string& symbol) { queue(symbol, false); }
+
+        // Write whatever is pending and stop the writer thread
+        void stop();
+
+        SubscriptionWriterStats stats() const;
+
+        SubscriptionWriter(const SubscriptionWriter&) = delete;
+        SubscriptionWriter& operator=(const SubscriptionWriter&) = delete;
+    };
+}
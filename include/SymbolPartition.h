@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace StockTracker {
+
+    // One DataService process in a partitioned deployment, as the others and
+    // clients reach it
+    struct PartitionMember {
+        std::string name;
+        std::string publish_endpoint;  // Its legacy CLI PUB socket
+        std::string feed_endpoint;     // Its quote feed XPUB socket (empty: no feed)
+        std::string request_endpoint;  // Its request server ROUTER socket
+    };
+
+    struct PartitionConfig {
+        // Empty: this instance serves every symbol. Otherwise every instance
+        // is configured with the same members and its own name as `self`.
+        std::vector<PartitionMember> members;
+        std::string self;
+        size_t virtual_nodes{ 64 };  // Ring points per member; more evens out the split
+    };
+
+    // Consistent-hash assignment of tickers to partition members. Each member
+    // is placed on a ring at `virtual_nodes` points; a ticker belongs to the
+    // first member point at or after its own hash. Adding or removing a member
+    // only moves the tickers on the arcs it gains or loses.
+    //
+    // The hash is FNV-1a, not std::hash, so every process (and build) agrees
+    // on the owner. Immutable after construction and safe to share.
+    class SymbolPartition {
+    private:
+        std::vector<PartitionMember> members;
+        std::vector<std::pair<uint64_t, size_t>> ring;  // (point, member index), sorted
+        size_t self_index{ 0 };
+
+        static uint64_t hash(const std::string& key);
+
+    public:
+        // Throws std::runtime_error if `self` is not a member or names repeat
+        explicit SymbolPartition(const PartitionConfig& config);
+
+        // False for a single-instance deployment, where owns() is always true
+        bool isPartitioned() const { return !members.empty(); }
+
+        bool owns(const std::string& symbol) const;
+
+        // Partitioned deployments only
+        const PartitionMember& owner(const std::string& symbol) const;
+        const std::vector<PartitionMember>& allMembers() const { return members; }
+        const PartitionMember& self() const { return members[self_index]; }
+        size_t selfIndex() const { return self_index; }  // 0 when not partitioned
+        // The first member answers CLI requests that span every member
+        bool isCoordinator() const { return self_index == 0; }
+    };
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace StockTracker {
+
+    // Dense integer id for a ticker, assigned by SymbolTable
+    using SymbolId = uint32_t;
+
+    // Interns tickers into dense ids so the hot path can key arrays and
+    // sets by integer instead of hashing and copying strings. Ids are never
+    // reused; names are only looked up again at the wire and DB boundaries.
+    class SymbolTable {
+    private:
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, SymbolId> ids;
+        std::deque<std::string> names;  // Indexed by id; elements never move
+
+    public:
+        // Id for a symbol, assigning the next free id if it is new
+        SymbolId intern(const std::string& symbol);
+
+        std::optional<SymbolId> find(const std::string& symbol) const;
+
+        // The returned reference stays valid for the table's lifetime
+        const std::string& name(SymbolId id) const;
+
+        size_t size() const;
+    };
+}
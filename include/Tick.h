@@ -0,0 +1,16 @@
+#pragma once
+#include "SymbolTable.h"
+#include <chrono>
+
+namespace StockTracker {
+
+    // A price update on the hot path. Unlike StockQuote it carries no
+    // strings; the symbol name is looked up only when a tick crosses the
+    // wire or DB boundary. Prices are USD unless stated otherwise.
+    struct Tick {
+        SymbolId symbol;
+        double price;
+        double change_percent;
+        std::chrono::system_clock::time_point timestamp;
+    };
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "MappedFile.h"
+#include "PriceStore.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace StockTracker {
+
+    struct TickJournalConfig {
+        bool enabled{ false };  // Store ticks here instead of as SQLite price rows
+        std::string directory{ "tick_journal" };
+        size_t segment_bytes{ 256 * 1024 * 1024 };  // Most a segment holds; a full one rolls to a new part
+        size_t segment_growth_bytes{ 8 * 1024 * 1024 };  // Segments grow in steps of this, trimmed once sealed
+        size_t index_block_records{ 4096 };          // Granularity of the per-symbol index
+        bool sync_each_batch{ false };               // Flush mapped pages after every append
+        std::chrono::hours retention{ 0 };           // Segments wholly older than this are deleted; 0 keeps all
+    };
+
+    struct TickJournalStats {
+        size_t segments{ 0 };
+        uint64_t records{ 0 };
+        uint64_t bytes{ 0 };  // Mapped segment storage
+    };
+
+    // Append-only tick store. Fixed 24-byte records go into memory-mapped
+    // segment files, one or more per UTC day:
+    //   <directory>/ticks-YYYYMMDD-<part>.seg   64-byte header, then records
+    //   <directory>/symbols.txt                 one name per line; line N is journal symbol N
+    // An append is a copy into the mapping. Each segment keeps, per symbol,
+    // the blocks of index_block_records that contain it, plus each block's
+    // time range, so a history scan reads only the blocks it needs, in order.
+    // The index is rebuilt from the records when a segment is opened.
+    //
+    // Segment files grow in segment_growth_bytes steps rather than being
+    // preallocated, since Windows backs a mapping's full size on disk. A
+    // segment that stops taking appends (rolled, or the journal closed) is
+    // trimmed to its committed records.
+    class TickJournal : public PriceStore {
+    private:
+        // Host byte order; the header records the size for validation
+        struct Record {
+            int64_t timestamp_us;
+            double price;
+            uint32_t symbol;  // Journal symbol, see symbols.txt
+            uint32_t reserved;
+        };
+        static_assert(sizeof(Record) == 24, "journal record layout");
+
+        struct Header {
+            char magic[8];
+            uint32_t record_size;
+            uint32_t part;
+            uint64_t records;  // Committed records; written after the records themselves
+            int64_t day;       // Days since the Unix epoch (UTC)
+            uint8_t reserved[32];
+        };
+        static_assert(sizeof(Header) == 64, "journal header layout");
+
+        struct Block {
+            int64_t min_us;
+            int64_t max_us;
+        };
+
+        struct Segment {
+            std::unique_ptr<MappedFile> file;
+            int64_t day{ 0 };
+            uint32_t part{ 0 };
+            size_t capacity{ 0 };  // Records it may grow to
+            size_t mapped{ 0 };    // Records the file currently has room for
+            size_t count{ 0 };
+            int64_t min_us{ INT64_MAX };
+            int64_t max_us{ INT64_MIN };
+            std::vector<Block> blocks;
+            std::vector<std::vector<uint32_t>> blocks_by_symbol;  // Journal symbol -> block numbers, ascending
+
+            Header& header() const { return *reinterpret_cast<Header*>(file->data()); }
+            Record* records() const { return reinterpret_cast<Record*>(file->data() + sizeof(Header)); }
+        };
+
+        SymbolTable& symbol_table;
+        const TickJournalConfig config;
+
+        mutable std::shared_mutex mutex;  // append() exclusive, history() shared
+        std::vector<std::unique_ptr<Segment>> segments;  // Oldest first; back() takes appends
+        std::vector<uint32_t> journal_ids;  // SymbolId -> journal symbol, or unassigned
+        std::vector<SymbolId> symbol_ids;   // Journal symbol -> SymbolId
+
+        void loadSymbols();
+        uint32_t journalSymbol(SymbolId symbol);
+        void loadSegments();
+        std::unique_ptr<Segment> openSegment(const std::string& path, int64_t day, uint32_t part, bool create);
+        void indexRecord(Segment& segment, size_t position);
+        // The segment taking appends for `day`, opening a new one if needed
+        Segment& segmentFor(int64_t day);
+        void commit(Segment& segment, size_t first);
+        void grow(Segment& segment);
+        void trim(Segment& segment);
+        void expireSegments(int64_t now_us);
+
+    public:
+        TickJournal(SymbolTable& symbol_table, const TickJournalConfig& config);
+        ~TickJournal() override;
+
+        size_t append(const std::vector<Tick>& ticks) override;
+        std::vector<PriceHistoryCache::Point> history(SymbolId symbol, TimePoint from, TimePoint to) override;
+
+        TickJournalStats stats() const;
+
+        TickJournal(const TickJournal&) = delete;
+        TickJournal& operator=(const TickJournal&) = delete;
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "SymbolTable.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace StockTracker {
+
+    struct TickSchedulerConfig {
+        std::chrono::milliseconds default_interval{ 8000 };
+        // Per-symbol overrides of default_interval
+        std::unordered_map<std::string, std::chrono::milliseconds> symbol_intervals;
+    };
+
+    // Min-heap of per-symbol deadlines for the update thread. Deadlines
+    // advance by a fixed interval from the previous deadline (not from when
+    // the tick finished), so the rate does not drift with processing cost.
+    // New symbols get a phase offset within their interval so a large
+    // universe ticks evenly instead of bursting all at once.
+    class TickScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        struct Entry {
+            Clock::time_point deadline;
+            uint64_t generation;
+            SymbolId symbol;
+
+            bool operator>(const Entry& other) const { return deadline > other.deadline; }
+        };
+
+        struct Slot {
+            Clock::duration interval{};
+            uint64_t generation{ 0 };  // 0 = not scheduled; heap entries with another generation are stale
+        };
+
+        const TickSchedulerConfig config;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        std::vector<Slot> slots;  // Indexed by SymbolId
+        uint64_t next_generation{ 0 };
+        uint64_t spread_index{ 0 };
+        bool stopped{ false };
+
+        Clock::duration phaseOffset(Clock::duration interval);
+        bool isCurrent(const Entry& entry) const;
+
+    public:
+        explicit TickScheduler(const TickSchedulerConfig& config = TickSchedulerConfig{});
+
+        // Start ticking a symbol (replaces any existing schedule)
+        void schedule(SymbolId symbol, std::chrono::milliseconds interval);
+
+        void cancel(SymbolId symbol);
+
+        // Configured interval for a ticker
+        std::chrono::milliseconds intervalFor(const std::string& symbol) const;
+
+        // Block until at least one symbol is due and append the due symbols
+        // to `due`. If `wake_by` is set, also return (possibly with nothing
+        // due) once that time passes. Returns false once stop() has been called.
+        bool waitDue(std::vector<SymbolId>& due, std::optional<Clock::time_point> wake_by = std::nullopt);
+
+        void stop();
+    };
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "SpscRing.h"
+#include "Tick.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace StockTracker {
+
+    // Ticks pushed by a streaming provider's feed thread and drained by the
+    // update thread. The ring itself is lock-free; the mutex is only taken
+    // to wake the consumer when it is asleep waiting for data.
+    class TickStream {
+    private:
+        SpscRing<Tick> ring;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        std::atomic<bool> consumer_waiting{ false };
+        std::atomic<bool> closed{ false };
+
+        std::atomic<uint64_t> pushed{ 0 };
+        std::atomic<uint64_t> dropped{ 0 };
+
+    public:
+        explicit TickStream(size_t capacity) : ring(capacity) {}
+
+        // Producer: never blocks; a tick that does not fit is dropped
+        bool push(const Tick& tick) {
+            if (!tryPush(tick)) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        }
+
+        // Producer: like push(), but a full ring is not counted as a drop.
+        // For producers that can wait and retry (file replay).
+        bool tryPush(const Tick& tick) {
+            if (!ring.tryPush(tick)) {
+                return false;
+            }
+            pushed.fetch_add(1, std::memory_order_relaxed);
+
+            // Pairs with the fence in wait(): either the consumer sees the
+            // tick or we see that it is waiting
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumer_waiting.load(std::memory_order_relaxed)) {
+                std::lock_guard lock(wake_mutex);
+                wake.notify_one();
+            }
+            return true;
+        }
+
+        // Consumer: move up to `max` ticks into `out`
+        size_t drain(std::vector<Tick>& out, size_t max) {
+            size_t count = 0;
+            Tick tick;
+            while (count < max && ring.tryPop(tick)) {
+                out.push_back(tick);
+                ++count;
+            }
+            return count;
+        }
+
+        // Consumer: sleep until ticks are available, `deadline` passes or the
+        // stream is closed. Returns false once closed.
+        bool wait(std::optional<std::chrono::steady_clock::time_point> deadline) {
+            std::unique_lock lock(wake_mutex);
+            consumer_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto ready = [this] { return closed.load() || !ring.empty(); };
+            if (deadline) {
+                wake.wait_until(lock, *deadline, ready);
+            }
+            else {
+                wake.wait(lock, ready);
+            }
+
+            consumer_waiting.store(false, std::memory_order_relaxed);
+            return !closed.load();
+        }
+
+        void close() {
+            closed = true;
+            std::lock_guard lock(wake_mutex);
+            wake.notify_all();
+        }
+
+        bool isClosed() const { return closed.load(); }
+
+        uint64_t pushedCount() const { return pushed.load(); }
+        uint64_t droppedCount() const { return dropped.load(); }
+    };
+}
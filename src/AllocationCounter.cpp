@@ -0,0 +1,37 @@
+// StockTracker.DataService/src/AllocationCounter.cpp
+#include "AllocationCounter.h"
+
+#ifdef STOCKTRACKER_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local uint64_t allocations = 0;
+
+    void* countedAllocate(std::size_t size) {
+        ++allocations;
+        if (void* p = std::malloc(size == 0 ? 1 : size)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+namespace StockTracker::AllocationCounter {
+
+    uint64_t threadAllocations() {
+#ifdef STOCKTRACKER_COUNT_ALLOCATIONS
+        return allocations;
+#else
+        return 0;
+#endif
+    }
+}
@@ -0,0 +1,139 @@
+// StockTracker.DataService/src/BarStore.cpp
+#include "BarStore.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    namespace {
+        const char* const InsertBar = "INSERT OR REPLACE INTO price_bars "
+            "(symbol, resolution, start_ms, open, high, low, close, count, mean, volatility) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+        const char* const SelectBars = "SELECT start_ms, open, high, low, close, count, mean, volatility "
+            "FROM price_bars WHERE symbol = ? AND resolution = ? AND start_ms < ? "
+            "ORDER BY start_ms DESC LIMIT ?";
+
+        const char* const SelectBarRange = "SELECT start_ms, open, high, low, close, count, mean, volatility "
+            "FROM price_bars WHERE symbol = ? AND resolution = ? AND start_ms >= ? AND start_ms < ? "
+            "ORDER BY start_ms";
+
+        int64_t toMillis(std::chrono::system_clock::time_point time) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+        }
+
+        std::chrono::system_clock::time_point fromMillis(int64_t millis) {
+            return std::chrono::system_clock::time_point(std::chrono::milliseconds(millis));
+        }
+
+        // Step a bound select to completion; false if it failed part way
+        bool readBars(sqlite3_stmt* select, SymbolId symbol, BarResolution resolution, std::vector<RollupBar>& bars) {
+            int rc;
+            while ((rc = sqlite3_step(select)) == SQLITE_ROW) {
+                RollupBar bar;
+                bar.symbol = symbol;
+                bar.resolution = resolution;
+                bar.ohlc.start = fromMillis(sqlite3_column_int64(select, 0));
+                bar.ohlc.open = sqlite3_column_double(select, 1);
+                bar.ohlc.high = sqlite3_column_double(select, 2);
+                bar.ohlc.low = sqlite3_column_double(select, 3);
+                bar.ohlc.close = sqlite3_column_double(select, 4);
+                bar.ohlc.count = static_cast<uint32_t>(sqlite3_column_int64(select, 5));
+                bar.mean = sqlite3_column_double(select, 6);
+                bar.volatility = sqlite3_column_double(select, 7);
+                bars.push_back(bar);
+            }
+            sqlite3_reset(select);
+            return rc == SQLITE_DONE;
+        }
+    }
+
+    BarStore::BarStore(const std::string& path, const DatabaseTuningConfig& tuning, const SymbolTable& symbol_table,
+        DatabaseMutex& database_mutex)
+        : symbol_table(symbol_table)
+        , database_mutex(database_mutex)
+        , connection(path, tuning)
+    {
+        std::lock_guard db_lock(database_mutex);
+        connection.exec("CREATE TABLE IF NOT EXISTS price_bars ("
+            "symbol TEXT NOT NULL, resolution TEXT NOT NULL, start_ms INTEGER NOT NULL, "
+            "open REAL, high REAL, low REAL, close REAL, count INTEGER, mean REAL, volatility REAL, "
+            "PRIMARY KEY (symbol, resolution, start_ms))");
+    }
+
+    void BarStore::save(const std::vector<RollupBar>& bars) {
+        if (bars.empty()) {
+            return;
+        }
+
+        std::scoped_lock lock(database_mutex, mutex);
+        connection.exec("BEGIN");
+        try {
+            for (const auto& bar : bars) {
+                const auto& name = symbol_table.name(bar.symbol);
+                sqlite3_stmt* insert = connection.statement(InsertBar);
+                sqlite3_bind_text(insert, 1, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+                sqlite3_bind_text(insert, 2, toString(bar.resolution), -1, SQLITE_STATIC);
+                sqlite3_bind_int64(insert, 3, toMillis(bar.ohlc.start));
+                sqlite3_bind_double(insert, 4, bar.ohlc.open);
+                sqlite3_bind_double(insert, 5, bar.ohlc.high);
+                sqlite3_bind_double(insert, 6, bar.ohlc.low);
+                sqlite3_bind_double(insert, 7, bar.ohlc.close);
+                sqlite3_bind_int64(insert, 8, bar.ohlc.count);
+                sqlite3_bind_double(insert, 9, bar.mean);
+                sqlite3_bind_double(insert, 10, bar.volatility);
+
+                if (sqlite3_step(insert) != SQLITE_DONE) {
+                    connection.fail("Failed to save bar");
+                }
+            }
+            connection.exec("COMMIT");
+        }
+        catch (...) {
+            sqlite3_exec(connection.handle(), "ROLLBACK", nullptr, nullptr, nullptr);
+            throw;
+        }
+    }
+
+    std::vector<RollupBar> BarStore::load(SymbolId symbol, BarResolution resolution,
+        std::chrono::system_clock::time_point before, size_t limit) const {
+        std::vector<RollupBar> bars;
+        if (limit == 0) {
+            return bars;
+        }
+
+        const auto& name = symbol_table.name(symbol);
+        std::lock_guard lock(mutex);
+        sqlite3_stmt* select = connection.statement(SelectBars);
+        sqlite3_bind_text(select, 1, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+        sqlite3_bind_text(select, 2, toString(resolution), -1, SQLITE_STATIC);
+        sqlite3_bind_int64(select, 3, toMillis(before));
+        sqlite3_bind_int64(select, 4, static_cast<sqlite3_int64>(limit));
+
+        if (!readBars(select, symbol, resolution, bars)) {
+            spdlog::error("Failed to load bars for {}: {}", name, sqlite3_errmsg(connection.handle()));
+        }
+
+        // Selected newest first so LIMIT keeps the latest ones
+        std::reverse(bars.begin(), bars.end());
+        return bars;
+    }
+
+    std::vector<RollupBar> BarStore::range(SymbolId symbol, BarResolution resolution,
+        std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const {
+        std::vector<RollupBar> bars;
+        const auto& name = symbol_table.name(symbol);
+
+        std::lock_guard lock(mutex);
+        sqlite3_stmt* select = connection.statement(SelectBarRange);
+        sqlite3_bind_text(select, 1, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+        sqlite3_bind_text(select, 2, toString(resolution), -1, SQLITE_STATIC);
+        sqlite3_bind_int64(select, 3, toMillis(from));
+        sqlite3_bind_int64(select, 4, toMillis(to));
+
+        if (!readBars(select, symbol, resolution, bars)) {
+            spdlog::error("Failed to load bars for {}: {}", name, sqlite3_errmsg(connection.handle()));
+        }
+        return bars;
+    }
+}
@@ -0,0 +1,23 @@
+// StockTracker.DataService/src/DataProvider.cpp
+#include "DataProvider.h"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    std::unique_ptr<IStockDataProvider> makeDataProvider(const DataProviderConfig& config,
+        SymbolTable& symbol_table, size_t streams) {
+        spdlog::info("Using {} data provider", config.kind);
+
+        if (config.kind == "mock") {
+            return std::make_unique<MockDataProvider>(symbol_table, streams, config.mock);
+        }
+        if (config.kind == "remote") {
+            return std::make_unique<RemoteDataProvider>(symbol_table, config.remote);
+        }
+        if (config.kind == "replay") {
+            return std::make_unique<ReplayDataProvider>(symbol_table, config.replay);
+        }
+        throw std::invalid_argument("Unknown data provider: " + config.kind);
+    }
+}
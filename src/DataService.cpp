@@ -1,29 +1,208 @@
 // StockTracker.DataService/src/DataService.cpp
 #include "DataService.h"
+#include "MetricsText.h"
 #include <spdlog/spdlog.h>
 #include <thread>
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 
 namespace StockTracker {
 
-    DataService::DataService()
+    namespace {
+        std::unique_ptr<PriceStore> makePriceStore(const DataServiceConfig& config, DatabaseMutex& database_mutex,
+            SymbolTable& symbol_table) {
+            if (config.tick_journal.enabled) {
+                return std::make_unique<TickJournal>(symbol_table, config.tick_journal);
+            }
+            return std::make_unique<SqlitePriceStore>(config.database_path, config.database, database_mutex,
+                symbol_table);
+        }
+
+        // "AAPL,MSFT GOOGL" -> { AAPL, MSFT, GOOGL }
+        std::vector<std::string> splitSymbols(const std::string& list) {
+            std::vector<std::string> symbols;
+            std::string symbol;
+            for (char c : list + ' ') {
+                if (c == ',' || std::isspace(static_cast<unsigned char>(c))) {
+                    if (!symbol.empty()) {
+                        symbols.push_back(std::move(symbol));
+                        symbol.clear();
+                    }
+                }
+                else {
+                    symbol.push_back(c);
+                }
+            }
+            return symbols;
+        }
+
+        // Reads the next argument into `value` if there is one, leaving the
+        // default at end of input. False if it is present but not a
+        // non-negative integer.
+        template <typename T>
+        bool readOptionalCount(std::istringstream& in, T& value) {
+            if ((in >> std::ws).eof()) {
+                return true;
+            }
+            int64_t parsed = 0;
+            in >> parsed;
+            if (in.fail() || parsed < 0) {
+                return false;
+            }
+            value = static_cast<T>(parsed);
+            return true;
+        }
+
+        // Binds the wakeup publisher and returns the endpoint it is on. An
+        // explicit endpoint is used as is; otherwise the first loopback port
+        // in the configured range that binds. MessageSocket cannot report an
+        // ephemeral port and may not share a context with the subscriber
+        // (which inproc:// needs), hence the scan.
+        std::string bindWakeup(MessageSocket& wakeup, const DataServiceConfig& config) {
+            if (!config.wakeup_endpoint.empty()) {
+                wakeup.bind(config.wakeup_endpoint);
+                return config.wakeup_endpoint;
+            }
+            for (uint32_t port = config.wakeup_first_port; port <= config.wakeup_last_port; ++port) {
+                auto endpoint = fmt::format("tcp://127.0.0.1:{}", port);
+                try {
+                    wakeup.bind(endpoint);
+                    return endpoint;
+                }
+                catch (const zmq::error_t&) {
+                    // In use, most likely by another instance on this host
+                }
+            }
+            throw std::runtime_error(fmt::format("No free wakeup port in {}-{}",
+                config.wakeup_first_port, config.wakeup_last_port));
+        }
+    }
+
+    DataService::DataService(const DataServiceConfig& config)
         : subscriber(zmq::socket_type::sub)
-        , publisher(zmq::socket_type::pub)
-        , db_service("stocktracker.db")
+        , publisher(config.publisher)
+        , wakeup(zmq::socket_type::pub)
+        , partition(config.partition)
+        , data_provider(makeDataProvider(config.provider, symbol_table, ShardPool::resolveCount(config.generators)))
+        , db_service(config.database_path)
+        , subscription_writer(db_service, database_mutex, config.subscriptions)
+        , bar_store(config.database_path, config.database, symbol_table, database_mutex)
+        , price_store(makePriceStore(config, database_mutex, symbol_table))
+        , price_writer(*price_store, bar_store, config.price_writer)
+        , history_cache(config.price_history)
         , currency_service()
+        , fx_rates(currency_service, config.fx_rates)
+        , tick_scheduler(config.tick_scheduler)
+        , legacy_history_max_points(config.legacy_history_max_points)
+        , stream_batch_size(config.provider.stream_batch_size)
+        , generators(config.generators,
+            [this](size_t shard, const std::vector<SymbolId>& ids) { generateShard(shard, ids); })
+        , shard_ticks(generators.size())
     {
         // Set up ZeroMQ sockets
-        subscriber.connect("tcp://localhost:5557");  // Listen for commands from CLI
-        publisher.bind("tcp://*:5556");             // Publish updates to CLI
+        subscriber.connect(config.command_endpoint);  // Listen for commands from CLI
+                                                      // (publisher binds its own endpoint)
+
+        // The command loop blocks in receive(); stop() wakes it through a
+        // second publisher the subscriber also listens to
+        subscriber.connect(bindWakeup(wakeup, config));
 
         // Subscribe to all command messages
         subscriber.setSubscribe("");
 
-        // Load any previously subscribed stocks from SQLite
-        auto subscriptions = db_service.getSubscriptions();
-        for (const auto& symbol : subscriptions) {
-            subscribed_stocks.insert(symbol);
-            spdlog::info("Restored subscription for {}", symbol);
+        // Streaming providers push ticks instead of being polled per cycle
+        auto stream = std::make_unique<TickStream>(config.provider.stream_capacity);
+        if (data_provider->startStreaming(*stream)) {
+            tick_stream = std::move(stream);
+        }
+
+        if (config.rollups.enabled) {
+            rollups = std::make_unique<RollupEngine>(config.rollups,
+                [this](const RollupBar& bar) { price_writer.enqueue(bar); });
+        }
+
+        if (config.retention.enabled) {
+            retention = std::make_unique<RetentionManager>(config.database_path, config.database, database_mutex,
+                config.retention);
+        }
+
+        if (config.quote_feed.enabled) {
+            quote_feed = std::make_unique<QuoteFeed>(fx_rates, symbol_table, config.quote_feed,
+                static_cast<uint32_t>(partition.selfIndex()));
+        }
+
+        if (partition.isPartitioned()) {
+            spdlog::info("Partition member {} of {}", partition.self().name, partition.allMembers().size());
+            if (partition.isCoordinator()) {
+                peers = std::make_unique<PartitionClient>();
+            }
+        }
+
+        if (config.forwarder.enabled) {
+            if (!partition.isPartitioned()) {
+                throw std::runtime_error("The publish forwarder needs partition members to forward");
+            }
+            PublishForwarder::Route publish_route{ config.forwarder.publish_frontend, {} };
+            PublishForwarder::Route feed_route{ config.forwarder.feed_frontend, {} };
+            for (const auto& member : partition.allMembers()) {
+                publish_route.backends.push_back(member.publish_endpoint);
+                if (!member.feed_endpoint.empty()) {
+                    feed_route.backends.push_back(member.feed_endpoint);
+                }
+            }
+            forwarder = std::make_unique<PublishForwarder>(
+                std::vector<PublishForwarder::Route>{ publish_route, feed_route });
+        }
+
+        // Load any previously subscribed stocks from SQLite. Members sharing
+        // one database each restore only their own symbols.
+        std::vector<SymbolId> restored;
+        auto stored_subscriptions = [this] {
+            std::lock_guard lock(database_mutex);
+            return db_service.getSubscriptions();
+        }();
+        for (const auto& symbol : stored_subscriptions) {
+            auto id = symbol_table.find(symbol);
+            if (!partition.owns(symbol)) {
+                spdlog::debug("Stored subscription for {} belongs to {}", symbol, partition.owner(symbol).name);
+            }
+            else if (id && data_provider->isValidSymbol(*id)) {
+                restored.push_back(*id);
+            }
+            else {
+                spdlog::warn("Ignoring stored subscription for unknown symbol {}", symbol);
+            }
+        }
+        const size_t stored = restored.size();
+        if (config.subscribe_all) {
+            for (const auto& symbol : ownedSymbols(data_provider->getAvailableSymbols())) {
+                restored.push_back(*symbol_table.find(symbol));
+            }
+        }
+        for (SymbolId id : subscribed_stocks.add(restored)) {
+            const auto& symbol = symbol_table.name(id);
+            tick_scheduler.schedule(id, tick_scheduler.intervalFor(symbol));
+            if (!config.subscribe_all) {
+                spdlog::info("Restored subscription for {}", symbol);
+            }
+        }
+        if (config.subscribe_all) {
+            spdlog::info("Subscribed to all {} provider symbols ({} stored)",
+                subscribed_stocks.snapshot()->size(), stored);
+        }
+
+        if (config.request_server.enabled) {
+            request_server = std::make_unique<RequestServer>(config.request_server,
+                [this](const std::string& request) { return handleRequest(request); });
+        }
+        if (config.metrics_server.enabled) {
+            metrics_server = std::make_unique<MetricsServer>(config.metrics_server,
+                [this] { return queryMetrics(); });
         }
 
         spdlog::info("DataService initialized");
@@ -33,36 +212,65 @@ namespace StockTracker {
     void DataService::handleMessage(const Message& msg) {
         try {
             switch (msg.type) {
-            case MessageType::Subscribe:
-                subscribeStock(msg.symbol);
+            // A comma or space separated list in the symbol field is a bulk
+            // request, e.g. a CLI restoring its watchlist. In a partitioned
+            // deployment every member sees every command and the owner of
+            // each symbol answers for it; the others stay silent.
+            case MessageType::Subscribe: {
+                auto symbols = splitSymbols(msg.symbol);
+                if (symbols.size() > 1) {
+                    subscribeMany(ownedSymbols(symbols));
+                }
+                else if (partition.owns(msg.symbol)) {
+                    subscribeStock(msg.symbol);
+                }
                 break;
+            }
 
-            case MessageType::Unsubscribe:
-                unsubscribeStock(msg.symbol);
+            case MessageType::Unsubscribe: {
+                auto symbols = splitSymbols(msg.symbol);
+                if (symbols.size() > 1) {
+                    unsubscribeMany(ownedSymbols(symbols));
+                }
+                else if (partition.owns(msg.symbol)) {
+                    unsubscribeStock(msg.symbol);
+                }
                 break;
+            }
 
             case MessageType::Query:
-                queryStock(msg.symbol);
+                if (partition.owns(msg.symbol)) {
+                    queryStock(msg.symbol);
+                }
                 break;
 
             case MessageType::PriceHistoryRequest:
-                sendPriceHistory(msg.symbol);
+                if (partition.owns(msg.symbol)) {
+                    sendPriceHistory(msg.symbol);
+                }
                 break;
 
+            // Spans every member, so only the coordinator replies
             case MessageType::RequestSubscriptions:
-                spdlog::info("Handling RequestSubscriptions");
-                sendSubscriptionsList();
+                if (!partition.isPartitioned() || partition.isCoordinator()) {
+                    spdlog::info("Handling RequestSubscriptions");
+                    sendSubscriptionsList();
+                }
                 break;
 
             case MessageType::SetCurrency:
                 spdlog::info("Handling currency change request to: {}", msg.currency);
                 if (CurrencyService::isValidCurrencyCode(msg.currency)) {
-                    current_currency = msg.currency;
-                    // Resend all current prices in new currency
-                    for (const auto& symbol : subscribed_stocks) {
-                        queryStock(symbol);
+                    {
+                        std::lock_guard lock(currency_mutex);
+                        current_currency = msg.currency;
                     }
-                    spdlog::info("Currency updated to {}", current_currency);
+
+                    // Resend every price once the rate is cached. A first
+                    // fetch runs on the FX refresh thread, so this loop never
+                    // waits on CurrencyService; ticks until then stay in USD.
+                    fx_rates.track(msg.currency, [this] { resendQuotes(); });
+                    spdlog::info("Currency updated to {}", msg.currency);
                 }
                 else {
                     publisher.send(Message::makeError("Invalid currency code: " + msg.currency));
@@ -81,40 +289,23 @@ namespace StockTracker {
     }
 
     void DataService::subscribeStock(const std::string& symbol) {
-        // Check if the symbol is valid (exists in mock data)
-        if (mock_data.isValidSymbol(symbol)) {
+        std::lock_guard lock(subscription_mutex);
+        // Check if the symbol is valid (known to the data provider)
+        auto id = symbol_table.find(symbol);
+        if (id && data_provider->isValidSymbol(*id)) {
             // Insert into the subscribed stocks set
-            if (subscribed_stocks.insert(symbol).second) {
+            if (subscribed_stocks.add(*id)) {
                 spdlog::info("Subscribed to {}", symbol);
+                tick_scheduler.schedule(*id, tick_scheduler.intervalFor(symbol));
 
-                // Persist the subscription in SQLite
-                db_service.saveSubscription(symbol);
+                // Persisted to SQLite in the background
+                subscription_writer.save(symbol);
 
                 // Send a confirmation message to the CLI
-                publisher.send(Message::makeSubscribe(symbol));
+                publisher.send(Message::makeSubscribe(symbol), *id);
 
                 // Send an immediate stock update using the current currency setting
-                auto quote = mock_data.generateQuote(symbol);
-                quote.currency = "USD";  // Set base currency
-
-                // Convert if not USD
-                if (current_currency != "USD") {
-                    try {
-                        // Get exchange rate
-                        double exchange_rate = currency_service.convertCurrency(1.0, current_currency);
-                        // Apply exchange rate to the price
-                        double converted_price = quote.price * exchange_rate;
-
-                        quote.price = converted_price;
-                        quote.currency = current_currency;
-                    }
-                    catch (const std::exception& e) {
-                        spdlog::error("Currency conversion failed on subscribe: {}", e.what());
-                    }
-                }
-
-                publisher.send(Message::makeQuoteUpdate(quote));
-                storeStockPrice(symbol, quote.price, quote.timestamp);
+                publishLegacy(generateTick(*id));
             }
             else {
                 spdlog::info("Already subscribed to {}", symbol);
@@ -128,16 +319,18 @@ namespace StockTracker {
     }
 
     void DataService::unsubscribeStock(const std::string& symbol) {
-        // Check if the symbol exists in the subscription list
-        if (subscribed_stocks.find(symbol) != subscribed_stocks.end()) {
-            // Remove the subscription from SQLite
-            db_service.removeSubscription(symbol);
+        std::lock_guard lock(subscription_mutex);
+        // Drop the symbol from the subscription list if it is there
+        auto id = symbol_table.find(symbol);
+        if (id && subscribed_stocks.remove(*id)) {
+            tick_scheduler.cancel(*id);
+            last_quotes.erase(*id);
 
-            // Erase from the set and log success
-            subscribed_stocks.erase(symbol);
+            // Removed from SQLite in the background
+            subscription_writer.remove(symbol);
 
             spdlog::info("Unsubscribed from {}", symbol);
-            publisher.send(Message::makeUnsubscribe(symbol)); // Notify client
+            publisher.send(Message::makeUnsubscribe(symbol), *id); // Notify client
         }
         else {
             // Log and send error if symbol is not found in subscriptions
@@ -146,35 +339,94 @@ namespace StockTracker {
         }
     }
 
+    size_t DataService::subscribeMany(const std::vector<std::string>& symbols) {
+        std::vector<SymbolId> ids;
+        std::vector<std::string> invalid;
+        for (const auto& symbol : symbols) {
+            auto id = symbol_table.find(symbol);
+            if (id && data_provider->isValidSymbol(*id)) {
+                ids.push_back(*id);
+            }
+            else {
+                invalid.push_back(symbol);
+            }
+        }
+
+        std::lock_guard lock(subscription_mutex);
+        auto added = subscribed_stocks.add(ids);
+        for (SymbolId id : added) {
+            const auto& symbol = symbol_table.name(id);
+            tick_scheduler.schedule(id, tick_scheduler.intervalFor(symbol));
+            subscription_writer.save(symbol);
+            publisher.send(Message::makeSubscribe(symbol), id);
+        }
+
+        // Initial quotes for the new symbols in one provider batch
+        std::vector<Tick> ticks;
+        data_provider->generateTicks(added.data(), added.size(), ticks);
+        for (const auto& tick : ticks) {
+            last_quotes.update(tick);
+            publishLegacy(tick);
+        }
+
+        spdlog::info("Subscribed to {} of {} requested symbols", added.size(), symbols.size());
+        if (!invalid.empty()) {
+            std::string message = "Invalid symbols:";
+            for (const auto& symbol : invalid) {
+                message += ' ' + symbol;
+            }
+            publisher.send(Message::makeError(message));
+        }
+        return added.size();
+    }
+
+    size_t DataService::unsubscribeMany(const std::vector<std::string>& symbols) {
+        std::vector<SymbolId> ids;
+        for (const auto& symbol : symbols) {
+            if (auto id = symbol_table.find(symbol)) {
+                ids.push_back(*id);
+            }
+        }
+
+        std::lock_guard lock(subscription_mutex);
+        auto removed = subscribed_stocks.remove(ids);
+        for (SymbolId id : removed) {
+            const auto& symbol = symbol_table.name(id);
+            tick_scheduler.cancel(id);
+            last_quotes.erase(id);
+            subscription_writer.remove(symbol);
+            publisher.send(Message::makeUnsubscribe(symbol), id);
+        }
+
+        spdlog::info("Unsubscribed from {} of {} requested symbols", removed.size(), symbols.size());
+        return removed.size();
+    }
+
+    // Symbols that have ticked are converted from their last USD quote; only
+    // ones with no quote yet need a fresh query
+    void DataService::resendQuotes() {
+        for (SymbolId id : *subscribed_stocks.snapshot()) {
+            if (auto last = last_quotes.get(id)) {
+                publisher.sendQuote(id, makeQuote(*last));
+            }
+            else {
+                queryStock(symbol_table.name(id));
+            }
+        }
+    }
+
     void DataService::queryStock(const std::string& symbol) {
-        if (!mock_data.isValidSymbol(symbol)) {
+        auto id = symbol_table.find(symbol);
+        if (!id || !data_provider->isValidSymbol(*id)) {
             publisher.send(Message::makeError("Invalid symbol: " + symbol));
             return;
         }
 
         try {
-            // Get base quote in USD
-            auto quote = mock_data.generateQuote(symbol);
-            quote.currency = "USD";
-
-            // Convert if not USD
-            if (current_currency != "USD") {
-                try {
-                    double converted_price = currency_service.convertCurrency(quote.price, current_currency);
-                    quote.price = converted_price;
-                    quote.currency = current_currency;
-                    spdlog::info("Converted price from USD ${:.2f} to {} {:.2f}",
-                        quote.price / converted_price, current_currency, converted_price);
-                }
-                catch (const std::exception& e) {
-                    spdlog::error("Currency conversion failed: {}", e.what());
-                    // Continue with USD price if conversion fails
-                }
-            }
-
-            publisher.send(Message::makeQuoteUpdate(quote));
-            storeStockPrice(symbol, quote.price, quote.timestamp);
-            spdlog::info("Sent quote for {} in {}: {}", symbol, quote.currency, quote.price);
+            // Fresh USD tick, sent in the current currency
+            auto tick = generateTick(*id);
+            publishLegacy(tick);
+            spdlog::debug("Sent quote for {}: {} USD", symbol, tick.price);
         }
         catch (const std::exception& e) {
             spdlog::error("Error querying stock {}: {}", symbol, e.what());
@@ -182,94 +434,729 @@ namespace StockTracker {
         }
     }
 
+    std::vector<PriceHistoryCache::Point> DataService::loadHistory(const std::string& symbol,
+        std::optional<std::chrono::system_clock::time_point> from,
+        std::optional<std::chrono::system_clock::time_point> to) {
+        std::vector<PriceHistoryCache::Point> recent;
+        auto id = symbol_table.find(symbol);
+        bool complete = id && history_cache.read(*id, recent);
+
+        // Served from memory alone if the cache holds everything, or at
+        // least everything the caller asked for
+        if (complete || (from && !recent.empty() && *from >= recent.front().timestamp)) {
+            return recent;
+        }
+
+        // Points older than the cached window only exist in the price
+        // store. Points inside the window come from memory, which also
+        // covers prices the writer has not flushed yet.
+        const auto cutoff = recent.empty()
+            ? std::chrono::system_clock::time_point::max()
+            : recent.front().timestamp;
+        const auto store_to = to ? std::min(*to, cutoff) : cutoff;
+
+        std::vector<PriceHistoryCache::Point> points;
+        if (id) {
+            points = price_store->history(*id, from.value_or(std::chrono::system_clock::time_point::min()), store_to);
+        }
+
+        if (!recent.empty() && !from && store_to == cutoff && points.empty()) {
+            history_cache.markComplete(*id, cutoff);
+        }
+
+        points.insert(points.end(), recent.begin(), recent.end());
+        return points;
+    }
+
     // Send price history to CLI
     void DataService::sendPriceHistory(const std::string& symbol) {
-        auto history = db_service.getPriceHistory(symbol);
+        auto points = loadHistory(symbol, std::nullopt, std::nullopt);
+
+        std::vector<StockQuote> history;
+        if (legacy_history_max_points != 0 && points.size() > legacy_history_max_points) {
+            // Downsample to the cap, one closing price per merged bar
+            PriceHistoryQuery query;
+            query.symbol = symbol;
+            query.max_points = legacy_history_max_points;
+            for (const auto& bar : aggregateBars(points, query)) {
+                history.push_back(StockQuote{ symbol, bar.close, bar.start });
+            }
+        }
+        else {
+            history.reserve(points.size());
+            for (const auto& point : points) {
+                history.push_back(StockQuote{ symbol, point.price, point.timestamp });
+            }
+        }
 
         publisher.send(Message::makePriceHistory(symbol, history));
 
-        spdlog::info("Sent price history for {}", symbol);
+        spdlog::info("Sent price history for {} ({} points)", symbol, history.size());
+    }
+
+    // Request endpoint protocol, one text frame each way:
+    //   HISTORY <SYMBOL> [FROM_MS] [TO_MS] [MAX_POINTS] [raw|1s|1m|1h]
+    // FROM_MS/TO_MS are Unix epoch milliseconds, 0 for an open end. Replies
+    // are "ERROR <reason>" or
+    //   BARS <SYMBOL> <RESOLUTION> <COUNT>
+    //   <START_MS> <OPEN> <HIGH> <LOW> <CLOSE> <TICKS>   (COUNT lines)
+    // Resolutions the rollup engine maintains are read from its bars (those
+    // starting inside the range); others are aggregated from raw ticks.
+    //
+    //   ROLLUP <SYMBOL> <1s|1m|1h> [COUNT]
+    // returns the latest COUNT (default 60) maintained bars, the last one
+    // still open:
+    //   ROLLUP <SYMBOL> <RESOLUTION> <COUNT>
+    //   <START_MS> <OPEN> <HIGH> <LOW> <CLOSE> <TICKS> <MEAN> <VOLATILITY>
+    //
+    //   SNAPSHOT [CURRENCY=<CCY>] [SYMBOL...]
+    // returns the last quote of every listed symbol (default: all that have
+    // one) from memory, in CCY or else the CLI's current currency:
+    //   SNAPSHOT <COUNT>
+    //   <SYMBOL> <PRICE> <CHANGE_PERCENT> <TIMESTAMP_MS> <CURRENCY>
+    //
+    //   SUBSCRIBE <SYMBOL>...  /  UNSUBSCRIBE <SYMBOL>...
+    // changes several subscriptions at once (symbols another partition
+    // member owns are skipped) and replies SUBSCRIBED|UNSUBSCRIBED <CHANGED>.
+    //
+    //   SUBSCRIPTIONS
+    // lists this instance's subscriptions: SUBSCRIPTIONS <COUNT>, then one
+    // symbol per line.
+    //
+    //   METRICS
+    // returns counters and latency summaries in Prometheus text format. The
+    // same text is served over HTTP by the metrics server when enabled.
+    //
+    //   PARTITION
+    // describes the deployment; "PARTITION - 0" for a single instance, else
+    //   PARTITION <SELF> <COUNT>
+    //   <NAME> <PUBLISH_ENDPOINT> <FEED_ENDPOINT> <REQUEST_ENDPOINT>
+    //
+    //   OWNER <SYMBOL>...
+    // says which member serves each symbol:
+    //   OWNER <COUNT>
+    //   <SYMBOL> <NAME> <REQUEST_ENDPOINT>
+    std::string DataService::handleRequest(const std::string& request) {
+        std::istringstream in(request);
+        std::string command;
+        in >> command;
+
+        if (command == "HISTORY") {
+            PriceHistoryQuery query;
+            int64_t from_ms = 0;
+            int64_t to_ms = 0;
+            std::string resolution = "raw";
+            in >> query.symbol;
+            bool valid = readOptionalCount(in, from_ms) && readOptionalCount(in, to_ms)
+                && readOptionalCount(in, query.max_points);
+            in >> resolution;
+
+            auto parsed = parseBarResolution(resolution);
+            if (query.symbol.empty() || !valid || !parsed) {
+                return "ERROR Usage: HISTORY <SYMBOL> [FROM_MS] [TO_MS] [MAX_POINTS] [raw|1s|1m|1h]";
+            }
+            if (!symbol_table.find(query.symbol)) {
+                return "ERROR Invalid symbol: " + query.symbol;
+            }
+
+            query.resolution = *parsed;
+            if (from_ms > 0) {
+                query.from = std::chrono::system_clock::time_point(std::chrono::milliseconds(from_ms));
+            }
+            if (to_ms > 0) {
+                query.to = std::chrono::system_clock::time_point(std::chrono::milliseconds(to_ms));
+            }
+            return queryHistory(query);
+        }
+
+        if (command == "ROLLUP") {
+            std::string symbol;
+            std::string resolution;
+            size_t count = 60;
+            in >> symbol >> resolution;
+            if (symbol.empty() || resolution.empty() || !readOptionalCount(in, count)) {
+                return "ERROR Usage: ROLLUP <SYMBOL> <1s|1m|1h> [COUNT]";
+            }
+
+            auto parsed = parseBarResolution(resolution);
+            if (!rollups || !parsed || !rollups->tracks(*parsed)) {
+                return "ERROR Rollups are not maintained at resolution " + resolution;
+            }
+            if (!symbol_table.find(symbol)) {
+                return "ERROR Invalid symbol: " + symbol;
+            }
+            return queryRollups(symbol, *parsed, count);
+        }
+
+        if (command == "SNAPSHOT") {
+            std::string currency = currentCurrency();
+            std::vector<std::string> symbols;
+            std::string token;
+            while (in >> token) {
+                if (token.rfind("CURRENCY=", 0) == 0) {
+                    currency = token.substr(9);
+                }
+                else {
+                    symbols.push_back(token);
+                }
+            }
+            return querySnapshot(currency, symbols);
+        }
+
+        if (command == "SUBSCRIBE" || command == "UNSUBSCRIBE") {
+            std::vector<std::string> symbols;
+            std::string symbol;
+            while (in >> symbol) {
+                symbols.push_back(symbol);
+            }
+            if (symbols.empty()) {
+                return "ERROR Usage: " + command + " <SYMBOL>...";
+            }
+            // Symbols another member owns are left to it
+            symbols = ownedSymbols(symbols);
+            size_t changed = command == "SUBSCRIBE" ? subscribeMany(symbols) : unsubscribeMany(symbols);
+            return fmt::format("{}D {}", command, changed);
+        }
+
+        if (command == "SUBSCRIPTIONS") {
+            auto symbols = subscribedSymbols();
+            fmt::memory_buffer out;
+            fmt::format_to(std::back_inserter(out), "SUBSCRIPTIONS {}\n", symbols.size());
+            for (const auto& symbol : symbols) {
+                fmt::format_to(std::back_inserter(out), "{}\n", symbol);
+            }
+            return fmt::to_string(out);
+        }
+
+        if (command == "METRICS") {
+            return queryMetrics();
+        }
+
+        if (command == "PARTITION") {
+            return queryPartition();
+        }
+
+        if (command == "OWNER") {
+            std::vector<std::string> symbols;
+            std::string symbol;
+            while (in >> symbol) {
+                symbols.push_back(symbol);
+            }
+            if (symbols.empty()) {
+                return "ERROR Usage: OWNER <SYMBOL>...";
+            }
+            return queryOwners(symbols);
+        }
+
+        return "ERROR Unknown request: " + command;
+    }
+
+    std::string DataService::queryHistory(const PriceHistoryQuery& query) {
+        auto bars = rollups && rollups->tracks(query.resolution)
+            ? loadRollupHistory(query)
+            : aggregateBars(loadHistory(query.symbol, query.from, query.to), query);
+
+        fmt::memory_buffer out;
+        fmt::format_to(std::back_inserter(out), "BARS {} {} {}\n",
+            query.symbol, toString(query.resolution), bars.size());
+        for (const auto& bar : bars) {
+            auto start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                bar.start.time_since_epoch()).count();
+            fmt::format_to(std::back_inserter(out), "{} {:.6f} {:.6f} {:.6f} {:.6f} {}\n",
+                start_ms, bar.open, bar.high, bar.low, bar.close, bar.count);
+        }
+        return fmt::to_string(out);
+    }
+
+    std::vector<PriceBar> DataService::loadRollupHistory(const PriceHistoryQuery& query) {
+        const SymbolId id = *symbol_table.find(query.symbol);
+        const auto from = query.from.value_or(std::chrono::system_clock::time_point::min());
+        const auto to = query.to.value_or(std::chrono::system_clock::time_point::max());
+        auto in_memory = rollups->recent(id, query.resolution, std::numeric_limits<size_t>::max());
+
+        // Bars older than the in-memory window come from the bar store
+        const auto cutoff = in_memory.empty() ? to : std::min(to, in_memory.front().ohlc.start);
+        std::vector<PriceBar> bars;
+        if (from < cutoff) {
+            for (const auto& bar : bar_store.range(id, query.resolution, from, cutoff)) {
+                bars.push_back(bar.ohlc);
+            }
+        }
+        for (const auto& bar : in_memory) {
+            if (bar.ohlc.start >= from && bar.ohlc.start < to) {
+                bars.push_back(bar.ohlc);
+            }
+        }
+        return fitBars(std::move(bars), query.max_points);
+    }
+
+    std::string DataService::queryRollups(const std::string& symbol, BarResolution resolution, size_t count) {
+        const SymbolId id = *symbol_table.find(symbol);
+        auto bars = rollups->recent(id, resolution, count);
+
+        // Bars that have aged out of memory come from the bar store
+        if (bars.size() < count) {
+            auto before = bars.empty() ? std::chrono::system_clock::now() : bars.front().ohlc.start;
+            auto older = bar_store.load(id, resolution, before, count - bars.size());
+            bars.insert(bars.begin(), older.begin(), older.end());
+        }
+
+        fmt::memory_buffer out;
+        fmt::format_to(std::back_inserter(out), "ROLLUP {} {} {}\n", symbol, toString(resolution), bars.size());
+        for (const auto& bar : bars) {
+            auto start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                bar.ohlc.start.time_since_epoch()).count();
+            fmt::format_to(std::back_inserter(out), "{} {:.6f} {:.6f} {:.6f} {:.6f} {} {:.6f} {:.8f}\n",
+                start_ms, bar.ohlc.open, bar.ohlc.high, bar.ohlc.low, bar.ohlc.close, bar.ohlc.count,
+                bar.mean, bar.volatility);
+        }
+        return fmt::to_string(out);
+    }
+
+    std::string DataService::querySnapshot(const std::string& currency, const std::vector<std::string>& symbols) {
+        // Cached rates only; a missing one is fetched for the next request
+        auto rate = fx_rates.rate(currency);
+        if (!rate) {
+            if (CurrencyService::isValidCurrencyCode(currency)) {
+                fx_rates.prefetch(currency);
+                return "ERROR No exchange rate for " + currency + " yet, retry shortly";
+            }
+            return "ERROR Invalid currency code: " + currency;
+        }
+
+        std::vector<Tick> ticks;
+        if (symbols.empty()) {
+            last_quotes.snapshot(ticks);
+        }
+        else {
+            for (const auto& symbol : symbols) {
+                auto id = symbol_table.find(symbol);
+                if (auto last = id ? last_quotes.get(*id) : std::nullopt) {
+                    ticks.push_back(*last);
+                }
+            }
+        }
+
+        std::sort(ticks.begin(), ticks.end(), [this](const Tick& a, const Tick& b) {
+            return symbol_table.name(a.symbol) < symbol_table.name(b.symbol);
+        });
+
+        fmt::memory_buffer out;
+        fmt::format_to(std::back_inserter(out), "SNAPSHOT {}\n", ticks.size());
+        for (const auto& tick : ticks) {
+            QuoteWire::encodeText(out, symbol_table.name(tick.symbol), tick.price * *rate,
+                tick.change_percent, tick.timestamp, currency);
+            out.push_back('\n');
+        }
+        return fmt::to_string(out);
+    }
+
+    std::string DataService::queryMetrics() const {
+        MetricsText metrics;
+        metrics.gauge("uptime_seconds", "Seconds since the service started",
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+        metrics.gauge("subscribed_symbols", "Symbols currently subscribed",
+            static_cast<double>(subscribed_stocks.snapshot()->size()));
+
+        // Tick path
+        metrics.counter("ticks_published_total", "Ticks converted and queued for the CLI and database",
+            ticks_published.load(std::memory_order_relaxed));
+        metrics.summary("provider_batch_seconds", "Time per data provider batch", provider_latency.summary());
+        metrics.summary("convert_seconds", "Time to build a quote in the CLI currency", convert_latency.summary());
+        metrics.summary("tick_seconds", "Time from generated tick to queued for the CLI and database",
+            tick_latency.summary());
+        if (AllocationCounter::enabled) {
+            metrics.counter("hot_path_allocations_total", "Heap allocations made by steady-state ticks",
+                hot_path_allocations.load());
+        }
+        if (tick_stream) {
+            metrics.counter("stream_ticks_total", "Ticks pushed by a streaming provider", tick_stream->pushedCount());
+            metrics.counter("stream_dropped_total", "Streamed ticks dropped because the ring was full",
+                tick_stream->droppedCount());
+        }
+
+        // CLI publisher
+        auto publish = publisher.stats();
+        metrics.counter("publish_sent_total", "Messages handed to the PUB socket", publish.sent);
+        metrics.counter("publish_conflated_total", "Quotes replaced by a newer one before sending", publish.conflated);
+        metrics.gauge("publish_queue_depth", "Messages waiting for the publisher thread",
+            static_cast<double>(publish.queue_depth + publish.pending_quotes));
+        metrics.gauge("publish_max_queue_depth", "Largest publisher queue depth seen",
+            static_cast<double>(publish.max_queue_depth));
+        metrics.summary("publish_latency_seconds", "Time from queued to handed to ZeroMQ", publish.latency);
+
+        // Price persistence
+        auto writer = price_writer.stats();
+        metrics.counter("db_written_total", "Prices written to SQLite", writer.written);
+        metrics.counter("db_dropped_total", "Prices dropped because the writer queue was full", writer.dropped);
+        metrics.counter("db_bars_written_total", "Rollup bars written to SQLite", writer.bars_written);
+        metrics.gauge("db_queue_depth", "Prices waiting for the writer thread", static_cast<double>(writer.queue_depth));
+        metrics.gauge("db_max_queue_depth", "Largest writer queue depth seen", static_cast<double>(writer.max_queue_depth));
+        metrics.summary("db_flush_seconds", "Time per batch write", writer.flush);
+        auto subscriptions = subscription_writer.stats();
+        metrics.counter("subscription_changes_total", "Subscription changes queued for SQLite", subscriptions.changes);
+        metrics.counter("subscription_coalesced_total", "Subscription changes superseded before a flush",
+            subscriptions.coalesced);
+        metrics.counter("subscription_flushes_total", "Batches of subscription changes written", subscriptions.flushes);
+
+        // Caches and maintenance
+        auto fx = fx_rates.stats();
+        metrics.counter("fx_refreshes_total", "Exchange rates fetched successfully", fx.refreshes);
+        metrics.counter("fx_refresh_failures_total", "Failed exchange rate fetches", fx.refresh_failures);
+        metrics.counter("fx_misses_total", "Conversions with no cached rate", fx.misses);
+        metrics.counter("fx_stale_lookups_total", "Conversions that found a rate older than max_staleness",
+            fx.stale_lookups);
+        metrics.gauge("fx_currencies", "Currencies with a cached rate", static_cast<double>(fx.currencies));
+        metrics.gauge("fx_oldest_rate_age_seconds", "Age of the oldest cached exchange rate",
+            fx.oldest_rate_age_ms / 1000.0);
+        auto history = history_cache.stats();
+        metrics.counter("history_cache_hits_total", "History requests served from memory", history.hits);
+        metrics.counter("history_cache_partial_hits_total",
+            "History requests served from memory plus older rows from the price store", history.partial_hits);
+        metrics.counter("history_cache_misses_total", "History requests that went to SQLite", history.misses);
+        metrics.gauge("history_cache_points", "Prices held in the history cache", static_cast<double>(history.points));
+        metrics.gauge("history_cache_bytes", "Ring storage reserved by the history cache",
+            static_cast<double>(history.bytes));
+        if (retention) {
+            auto swept = retention->stats();
+            metrics.counter("retention_sweeps_total", "Retention sweeps run", swept.sweeps);
+            metrics.counter("retention_ticks_deleted_total", "Expired ticks deleted", swept.ticks_deleted);
+            metrics.counter("retention_bars_deleted_total", "Expired rollup bars deleted", swept.bars_deleted);
+            metrics.counter("retention_pages_vacuumed_total", "Database pages returned by incremental vacuum",
+                swept.pages_vacuumed);
+        }
+        return metrics.str();
+    }
+
+    std::string DataService::queryPartition() const {
+        if (!partition.isPartitioned()) {
+            return "PARTITION - 0\n";
+        }
+
+        // Empty endpoints are written as "-" so every line has four fields
+        auto field = [](const std::string& value) { return value.empty() ? std::string("-") : value; };
+        fmt::memory_buffer out;
+        fmt::format_to(std::back_inserter(out), "PARTITION {} {}\n",
+            partition.self().name, partition.allMembers().size());
+        for (const auto& member : partition.allMembers()) {
+            fmt::format_to(std::back_inserter(out), "{} {} {} {}\n", member.name,
+                field(member.publish_endpoint), field(member.feed_endpoint), field(member.request_endpoint));
+        }
+        return fmt::to_string(out);
+    }
+
+    std::string DataService::queryOwners(const std::vector<std::string>& symbols) const {
+        if (!partition.isPartitioned()) {
+            return "ERROR This instance is not partitioned; it serves every symbol";
+        }
+
+        fmt::memory_buffer out;
+        fmt::format_to(std::back_inserter(out), "OWNER {}\n", symbols.size());
+        for (const auto& symbol : symbols) {
+            const auto& owner = partition.owner(symbol);
+            fmt::format_to(std::back_inserter(out), "{} {} {}\n", symbol, owner.name, owner.request_endpoint);
+        }
+        return fmt::to_string(out);
+    }
+
+    std::vector<std::string> DataService::ownedSymbols(const std::vector<std::string>& symbols) const {
+        if (!partition.isPartitioned()) {
+            return symbols;
+        }
+        std::vector<std::string> owned;
+        std::copy_if(symbols.begin(), symbols.end(), std::back_inserter(owned),
+            [this](const std::string& symbol) { return partition.owns(symbol); });
+        return owned;
+    }
+
+    // The registry is the source of truth; SQLite may lag it by a flush
+    std::vector<std::string> DataService::subscribedSymbols() const {
+        std::vector<std::string> symbols;
+        for (SymbolId id : *subscribed_stocks.snapshot()) {
+            symbols.push_back(symbol_table.name(id));
+        }
+        std::sort(symbols.begin(), symbols.end());
+        return symbols;
     }
 
     void DataService::sendSubscriptionsList() {
-        auto subscriptions = db_service.getSubscriptions();
+        auto subscriptions = subscribedSymbols();
+
+        // The other members' lists, from their request endpoints. A member
+        // that does not answer in time is left out rather than stalling the
+        // command loop.
+        if (peers) {
+            std::vector<std::string> endpoints;
+            for (const auto& member : partition.allMembers()) {
+                if (&member != &partition.self()) {
+                    endpoints.push_back(member.request_endpoint);
+                }
+            }
+            for (const auto& reply : peers->requestAll(endpoints, "SUBSCRIPTIONS")) {
+                std::istringstream in(reply.value_or(""));
+                std::string header;
+                size_t count = 0;
+                if (!(in >> header >> count) || header != "SUBSCRIPTIONS") {
+                    continue;
+                }
+                std::string symbol;
+                while (count-- > 0 && in >> symbol) {
+                    subscriptions.push_back(symbol);
+                }
+            }
+            std::sort(subscriptions.begin(), subscriptions.end());
+        }
         spdlog::info("Sending subscription list with {} entries to CLI", subscriptions.size());
-        for (const auto& symbol : subscriptions) {
-            spdlog::info("Subscription symbol: {}", symbol);
+        if (spdlog::should_log(spdlog::level::trace)) {
+            for (const auto& symbol : subscriptions) {
+                spdlog::trace("Subscription symbol: {}", symbol);
+            }
         }
 
         Message msg = Message::makeSubscriptionsList(subscriptions);
         publisher.send(msg);  // Send to CLI
-        spdlog::info("SubscriptionsList message sent to CLI.");
+        spdlog::debug("SubscriptionsList message sent to CLI.");
     }
 
-    void DataService::storeStockPrice(const std::string& symbol, double price,
+    void DataService::storeStockPrice(SymbolId symbol, double price,
         const std::chrono::system_clock::time_point& timestamp) {
         
-        StockQuote quote{ symbol, price, timestamp };
-        db_service.savePrice(quote);
+        // Persisted asynchronously by the price writer; the history cache
+        // keeps the latest of the same points in memory
+        price_writer.enqueue(Tick{ symbol, price, 0.0, timestamp });
+        history_cache.record(symbol, price, timestamp);
+    }
+
+    Tick DataService::generateTick(SymbolId id) {
+        std::vector<Tick> ticks;
+        data_provider->generateTicks(&id, 1, ticks);
+        if (ticks.empty()) {
+            throw std::runtime_error("No quote available for " + symbol_table.name(id));
+        }
+        last_quotes.update(ticks.front());
+        return ticks.front();
+    }
+
+    StockQuote DataService::makeQuote(const Tick& tick) const {
+        std::string currency = currentCurrency();
+        double rate = 1.0;
+        if (currency != "USD") {
+            // Cached rate: a lookup and a multiply, no CurrencyService call
+            if (auto cached = fx_rates.rate(currency)) {
+                rate = *cached;
+            }
+            else {
+                uint64_t suppressed = 0;
+                if (conversion_error_log.allow(suppressed)) {
+                    spdlog::warn("No usable exchange rate for {}. Using original USD price. ({} similar warnings suppressed)",
+                        currency, suppressed);
+                }
+                currency = "USD";
+            }
+        }
+
+        StockQuote quote{ symbol_table.name(tick.symbol), tick.price * rate, tick.timestamp };
+        quote.change_percent = tick.change_percent;
+        quote.currency = std::move(currency);
+        return quote;
+    }
+
+    void DataService::publishLegacy(const Tick& tick) {
+        auto start = LatencyHistogram::Clock::now();
+        auto quote = makeQuote(tick);
+        convert_latency.recordSince(start);
+
+        storeStockPrice(tick.symbol, quote.price, quote.timestamp);
+        publisher.sendQuote(tick.symbol, std::move(quote));
+    }
+
+    std::string DataService::currentCurrency() const {
+        std::lock_guard lock(currency_mutex);
+        return current_currency;
+    }
+
+    void DataService::updateStocks(const std::vector<SymbolId>& symbols) {
+        // A symbol may have been unsubscribed after it became due
+        auto subscriptions = subscribed_stocks.snapshot();
+
+        due_ids.clear();
+        for (SymbolId id : symbols) {
+            if (subscriptions->count(id) != 0) {
+                due_ids.push_back(id);
+            }
+        }
+
+        // Generated, converted, sent and stored by the shards in parallel
+        for (auto& ticks : shard_ticks) {
+            ticks.clear();
+        }
+        generators.run(due_ids);
+
+        // The topic feed socket and the rollups belong to this thread
+        for (const auto& ticks : shard_ticks) {
+            if (rollups) {
+                rollups->update(ticks);
+            }
+
+            // Fan out to every currency the topic feed has listeners for
+            if (quote_feed) {
+                for (const auto& tick : ticks) {
+                    quote_feed->publish(tick);
+                }
+            }
+        }
     }
 
-    StockQuote DataService::convertQuoteCurrency(const StockQuote& quote) {
-        if (current_currency == "USD" || current_currency == quote.currency) {
-            return quote; // No conversion needed
+    void DataService::generateShard(size_t shard, const std::vector<SymbolId>& ids) {
+        // Base ticks in USD in one batch. The shard's ids all map to the same
+        // mock generator stream; a remote provider pipelines the shards'
+        // requests over its one connection.
+        auto& ticks = shard_ticks[shard];
+        auto start = LatencyHistogram::Clock::now();
+        data_provider->generateTicks(ids.data(), ids.size(), ticks);
+        provider_latency.recordSince(start);
+
+        for (const auto& tick : ticks) {
+            publishUpdate(tick);
         }
+    }
 
+    void DataService::publishUpdate(const Tick& tick) {
+        const uint64_t allocations_before = AllocationCounter::threadAllocations();
+        auto start = LatencyHistogram::Clock::now();
         try {
-            StockQuote converted = quote;
-            converted.price = currency_service.convertCurrency(quote.price, current_currency);
-            converted.currency = current_currency;
-            return converted;
+            bool first_tick = last_quotes.update(tick);
+            publishLegacy(tick);
+            tick_latency.recordSince(start);
+            ticks_published.fetch_add(1, std::memory_order_relaxed);
+
+            // Once a symbol has ticked, every container on this path has its
+            // capacity, so later ticks should not allocate at all
+            if (AllocationCounter::enabled && !first_tick) {
+                uint64_t allocations = AllocationCounter::threadAllocations() - allocations_before;
+                if (allocations != 0 && hot_path_allocations.fetch_add(allocations) == 0) {
+                    spdlog::error("Steady-state tick for {} made {} heap allocations",
+                        symbol_table.name(tick.symbol), allocations);
+                }
+            }
         }
         catch (const std::exception& e) {
-            spdlog::warn("Currency conversion failed: {}. Using original USD price.", e.what());
-            return quote; // Return original quote on error
+            uint64_t suppressed = 0;
+            if (publish_error_log.allow(suppressed)) {
+                spdlog::error("Error publishing quote for symbol id {}: {} ({} similar errors suppressed)",
+                    tick.symbol, e.what(), suppressed);
+            }
         }
     }
 
+    void DataService::publishStreamed(const std::vector<Tick>& ticks) {
+        auto subscriptions = subscribed_stocks.snapshot();
+
+        due_ticks.clear();
+        for (const auto& tick : ticks) {
+            if (subscriptions->count(tick.symbol) != 0) {
+                due_ticks.push_back(tick);
+            }
+        }
+
+        for (const auto& tick : due_ticks) {
+            publishUpdate(tick);
+        }
+
+        if (rollups) {
+            rollups->update(due_ticks);
+        }
+        if (quote_feed) {
+            for (const auto& tick : due_ticks) {
+                quote_feed->publish(tick);
+            }
+        }
+    }
+
+    void DataService::pollUpdates() {
+        std::vector<SymbolId> due;
+        while (running) {
+            // Also wake when a pending feed batch is due to go out
+            auto wake_by = quote_feed ? quote_feed->flushDeadline() : std::nullopt;
+            if (!tick_scheduler.waitDue(due, wake_by)) {
+                break;
+            }
+
+            if (quote_feed) {
+                quote_feed->beginCycle();
+            }
+
+            updateStocks(due);
+            due.clear();
+
+            if (rollups) {
+                rollups->closeExpired(std::chrono::system_clock::now());
+            }
+
+            if (quote_feed) {
+                quote_feed->endCycle();
+            }
+        }
+    }
+
+    void DataService::streamUpdates() {
+        std::vector<Tick> batch;
+        batch.reserve(stream_batch_size);
+
+        while (running) {
+            // Wake for new ticks, a pending feed batch, or at least once a
+            // second so rollup bars of quiet symbols still close
+            auto wake_by = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            if (auto flush = quote_feed ? quote_feed->flushDeadline() : std::nullopt) {
+                wake_by = std::min(wake_by, *flush);
+            }
+            if (!tick_stream->wait(wake_by)) {
+                break;
+            }
+
+            if (quote_feed) {
+                quote_feed->beginCycle();
+            }
+
+            batch.clear();
+            tick_stream->drain(batch, stream_batch_size);
+            publishStreamed(batch);
+
+            if (rollups) {
+                rollups->closeExpired(std::chrono::system_clock::now());
+            }
+
+            if (quote_feed) {
+                quote_feed->endCycle();
+            }
+        }
+
+        spdlog::info("Tick stream closed: {} ticks received, {} dropped (ring full)",
+            tick_stream->pushedCount(), tick_stream->droppedCount());
+    }
+
     void DataService::run() {
         // Start update thread for subscribed stocks
         std::thread update_thread([this]() {
-            while (running) {
-                for (const auto& symbol : subscribed_stocks) {
-                    try {
-                        // Get base quote in USD
-                        auto quote = mock_data.generateQuote(symbol);
-                        quote.currency = "USD";
-
-                        // Convert if not USD
-                        if (current_currency != "USD") {
-                            try {
-                                double converted_price = currency_service.convertCurrency(quote.price, current_currency);
-                                quote.price = converted_price;
-                                quote.currency = current_currency;
-                            }
-                            catch (const std::exception& e) {
-                                spdlog::error("Currency conversion failed for {}: {}", symbol, e.what());
-                                // Continue with USD price if conversion fails
-                            }
-                        }
-
-                        publisher.send(Message::makeQuoteUpdate(quote));
-                        storeStockPrice(symbol, quote.price, quote.timestamp);
-                    }
-                    catch (const std::exception& e) {
-                        spdlog::error("Error generating quote for {}: {}", symbol, e.what());
-                    }
-                }
-                std::this_thread::sleep_for(std::chrono::seconds(8));
+            if (tick_stream) {
+                streamUpdates();
+            }
+            else {
+                pollUpdates();
             }
             });
 
-        // Handle incoming messages in main thread
+        // Handle incoming messages in main thread. The receive blocks without
+        // spinning; stop() clears `running` and then sends a wakeup message.
         while (running) {
             try {
-                if (auto msg = subscriber.receive(false)) {  // Blocking receive
-                    spdlog::info("Received message of type: {}", static_cast<int>(msg->type));
-                    handleMessage(*msg);
+                auto msg = subscriber.receive(false);  // Blocking receive
+                if (!running) {
+                    break;
                 }
-                else {
-                    spdlog::warn("Blocking receive unexpectedly returned no message.");
+                if (msg) {
+                    spdlog::debug("Received message of type: {}", static_cast<int>(msg->type));
+                    handleMessage(*msg);
                 }
             }
             catch (const std::exception& e) {
@@ -280,10 +1167,45 @@ namespace StockTracker {
         if (update_thread.joinable()) {
             update_thread.join();
         }
+
+        if (request_server) {
+            request_server->stop();
+        }
+        if (metrics_server) {
+            metrics_server->stop();
+        }
+        generators.stop();
+
+        if (retention) {
+            retention->stop();
+        }
+
+        if (AllocationCounter::enabled) {
+            spdlog::info("Heap allocations on steady-state ticks: {}", hot_path_allocations.load());
+        }
+
+        // Flush anything still queued for the database and the CLI
+        subscription_writer.stop();
+        price_writer.stop();
+        fx_rates.stop();
+        publisher.stop();
+
+        // Last, so what this member just flushed still reaches the CLI
+        if (forwarder) {
+            forwarder->stop();
+        }
     }
 
     void DataService::stop() {
         running = false;
+        tick_scheduler.stop();
+        if (tick_stream) {
+            tick_stream->close();
+        }
+
+        // Any message will do; the command loop checks `running` first
+        std::lock_guard lock(wakeup_mutex);
+        wakeup.send(Message::makeError("shutdown"));
     }
 
 }
\ No newline at end of file
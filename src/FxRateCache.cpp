@@ -0,0 +1,176 @@
+// StockTracker.DataService/src/FxRateCache.cpp
+#include "FxRateCache.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    FxRateCache::FxRateCache(CurrencyService& currency_service, const FxRateCacheConfig& config)
+        : currency_service(currency_service)
+        , config(config)
+        , table(std::make_shared<const Table>())
+    {
+        refresh_thread = std::thread(&FxRateCache::refreshLoop, this);
+    }
+
+    FxRateCache::~FxRateCache() {
+        stop();
+    }
+
+    std::shared_ptr<const FxRateCache::Table> FxRateCache::load() const {
+        return std::atomic_load_explicit(&table, std::memory_order_acquire);
+    }
+
+    std::optional<double> FxRateCache::rate(const std::string& currency) const {
+        if (currency == "USD") {
+            return 1.0;
+        }
+
+        auto rates = load();
+        auto it = rates->find(currency);
+        if (it == rates->end()) {
+            ++misses;
+            return std::nullopt;
+        }
+
+        if (Clock::now() - it->second.updated > config.max_staleness) {
+            ++stale_lookups;
+            if (config.fallback_policy == FxFallbackPolicy::UseBaseCurrency) {
+                return std::nullopt;
+            }
+        }
+        return it->second.rate;
+    }
+
+    void FxRateCache::prefetch(const std::string& currency) {
+        if (currency == "USD") {
+            return;
+        }
+
+        {
+            std::lock_guard lock(wake_mutex);
+            pending.insert(currency);
+        }
+        wake.notify_all();
+    }
+
+    void FxRateCache::track(const std::string& currency, std::function<void()> on_ready) {
+        if (currency == "USD" || load()->count(currency) != 0) {
+            prefetch(currency);  // Only adds it to the refresh set
+            on_ready();
+            return;
+        }
+
+        {
+            std::lock_guard lock(wake_mutex);
+            pending.insert(currency);
+            waiting.push_back(std::move(on_ready));
+        }
+        wake.notify_all();
+    }
+
+    // Caller holds fetch_mutex
+    void FxRateCache::fetch(const std::unordered_set<std::string>& currencies) {
+        if (currencies.empty()) {
+            return;
+        }
+
+        // Start from the current table so a failed refresh keeps the old rate
+        auto next = std::make_shared<Table>(*load());
+        for (const auto& currency : currencies) {
+            try {
+                // Fetched before indexing, so a throw never leaves a zero rate behind
+                double fetched = currency_service.convertCurrency(1.0, currency);
+                (*next)[currency] = Rate{ fetched, Clock::now() };
+                ++refreshes;
+            }
+            catch (const std::exception& e) {
+                ++refresh_failures;
+                spdlog::warn("Exchange rate refresh failed for {}: {}", currency, e.what());
+            }
+        }
+
+        std::atomic_store_explicit(&table, std::shared_ptr<const Table>(std::move(next)),
+            std::memory_order_release);
+    }
+
+    void FxRateCache::refreshLoop() {
+        auto next_refresh = Clock::now() + config.refresh_interval;
+
+        std::unique_lock lock(wake_mutex);
+        while (!stopping) {
+            wake.wait_until(lock, next_refresh, [this] { return stopping || !pending.empty(); });
+            if (stopping) {
+                break;
+            }
+
+            std::unordered_set<std::string> requested;
+            requested.swap(pending);
+            std::vector<std::function<void()>> callbacks;
+            callbacks.swap(waiting);
+            lock.unlock();
+
+            {
+                std::lock_guard fetch_lock(fetch_mutex);
+                if (!requested.empty()) {
+                    // Newly requested currencies: fetch just those now
+                    std::unordered_set<std::string> missing;
+                    for (const auto& currency : requested) {
+                        tracked.insert(currency);
+                        if (load()->count(currency) == 0) {
+                            missing.insert(currency);
+                        }
+                    }
+                    fetch(missing);
+                }
+
+                if (Clock::now() >= next_refresh) {
+                    fetch(tracked);
+                    next_refresh = Clock::now() + config.refresh_interval;
+                }
+            }
+
+            // Outside fetch_mutex, so a callback may use the cache again
+            for (auto& callback : callbacks) {
+                try {
+                    callback();
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("Exchange rate callback failed: {}", e.what());
+                }
+            }
+
+            lock.lock();
+        }
+    }
+
+    void FxRateCache::stop() {
+        {
+            std::lock_guard lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        if (refresh_thread.joinable()) {
+            refresh_thread.join();
+        }
+    }
+
+    FxRateStats FxRateCache::stats() const {
+        FxRateStats s;
+        s.refreshes = refreshes.load();
+        s.refresh_failures = refresh_failures.load();
+        s.misses = misses.load();
+        s.stale_lookups = stale_lookups.load();
+
+        auto rates = load();
+        s.currencies = rates->size();
+
+        auto now = Clock::now();
+        for (const auto& [currency, rate] : *rates) {
+            double age_ms = std::chrono::duration<double, std::milli>(now - rate.updated).count();
+            s.oldest_rate_age_ms = std::max(s.oldest_rate_age_ms, age_ms);
+        }
+        return s;
+    }
+}
@@ -0,0 +1,36 @@
+// StockTracker.DataService/src/LastValueTable.cpp
+#include "LastValueTable.h"
+
+namespace StockTracker {
+
+    bool LastValueTable::update(const Tick& tick) {
+        std::lock_guard lock(mutex);
+        auto [it, inserted] = ticks.try_emplace(tick.symbol, tick);
+        if (!inserted) {
+            it->second = tick;
+        }
+        return inserted;
+    }
+
+    void LastValueTable::erase(SymbolId symbol) {
+        std::lock_guard lock(mutex);
+        ticks.erase(symbol);
+    }
+
+    std::optional<Tick> LastValueTable::get(SymbolId symbol) const {
+        std::lock_guard lock(mutex);
+        auto it = ticks.find(symbol);
+        if (it == ticks.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void LastValueTable::snapshot(std::vector<Tick>& out) const {
+        std::lock_guard lock(mutex);
+        out.reserve(out.size() + ticks.size());
+        for (const auto& [symbol, tick] : ticks) {
+            out.push_back(tick);
+        }
+    }
+}
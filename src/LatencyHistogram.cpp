@@ -0,0 +1,91 @@
+// StockTracker.DataService/src/LatencyHistogram.cpp
+#include "LatencyHistogram.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace StockTracker {
+
+    namespace {
+        // Index of the highest set bit; v must be non-zero
+        unsigned highestBit(uint64_t v) {
+#ifdef _MSC_VER
+            unsigned long index = 0;
+            _BitScanReverse64(&index, v);
+            return static_cast<unsigned>(index);
+#else
+            return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#endif
+        }
+    }
+
+    size_t LatencyHistogram::bucketFor(uint64_t ns) {
+        // Values below sub_buckets get one bucket each; above that, the top
+        // set bit picks the power of two and the next four bits the sub-bucket
+        if (ns < sub_buckets) {
+            return static_cast<size_t>(ns);
+        }
+        unsigned exponent = highestBit(ns);
+        size_t sub = static_cast<size_t>(ns >> (exponent - sub_bucket_bits)) & (sub_buckets - 1);
+        return (exponent - sub_bucket_bits + 1) * sub_buckets + sub;
+    }
+
+    uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+        if (bucket < sub_buckets) {
+            return bucket;
+        }
+        unsigned exponent = static_cast<unsigned>(bucket / sub_buckets) + sub_bucket_bits - 1;
+        uint64_t sub = bucket % sub_buckets;
+        uint64_t lower = (sub_buckets + sub) << (exponent - sub_bucket_bits);
+        return lower + (uint64_t{ 1 } << (exponent - sub_bucket_bits)) - 1;
+    }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds elapsed) {
+        const uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+
+        buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t seen = max_ns.load(std::memory_order_relaxed);
+        while (ns > seen && !max_ns.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+
+        // Last, so a reader never sees a count larger than the bucket total
+        count.fetch_add(1, std::memory_order_release);
+    }
+
+    LatencySummary LatencyHistogram::summary() const {
+        LatencySummary s;
+        s.count = count.load(std::memory_order_acquire);
+        s.sum_ns = sum_ns.load(std::memory_order_relaxed);
+        s.max_ns = max_ns.load(std::memory_order_relaxed);
+        if (s.count == 0) {
+            return s;
+        }
+
+        // Ranks of each percentile, 1-based
+        const uint64_t rank50 = std::max<uint64_t>((s.count * 500 + 999) / 1000, 1);
+        const uint64_t rank99 = std::max<uint64_t>((s.count * 990 + 999) / 1000, 1);
+        const uint64_t rank999 = std::max<uint64_t>((s.count * 999 + 999) / 1000, 1);
+
+        // Records that land while scanning can leave a rank unreached; those
+        // percentiles report the max
+        s.p50_ns = s.p99_ns = s.p999_ns = s.max_ns;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count && seen < rank999; ++i) {
+            uint64_t n = buckets[i].load(std::memory_order_relaxed);
+            if (n == 0) {
+                continue;
+            }
+            const uint64_t before = seen;
+            seen += n;
+            const uint64_t bound = std::min(bucketUpperBound(i), s.max_ns);
+            if (before < rank50 && seen >= rank50) s.p50_ns = bound;
+            if (before < rank99 && seen >= rank99) s.p99_ns = bound;
+            if (before < rank999 && seen >= rank999) s.p999_ns = bound;
+        }
+        return s;
+    }
+}
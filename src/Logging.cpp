@@ -0,0 +1,32 @@
+// StockTracker.DataService/src/Logging.cpp
+#include "Logging.h"
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    void configureLogging(const LoggingConfig& config) {
+        std::shared_ptr<spdlog::logger> logger;
+        if (config.async) {
+            // One formatting thread; a full queue overwrites the oldest entry
+            // rather than blocking the thread that logged
+            spdlog::init_thread_pool(std::max<size_t>(config.queue_size, 1), 1);
+            logger = spdlog::create_async_nb<spdlog::sinks::stdout_color_sink_mt>("stocktracker");
+        }
+        else {
+            logger = spdlog::stdout_color_mt("stocktracker");
+        }
+
+        logger->set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
+        logger->set_level(config.level);
+        // Errors reach the console promptly even if the process dies after
+        logger->flush_on(spdlog::level::err);
+        spdlog::set_default_logger(std::move(logger));
+    }
+
+    void shutdownLogging() {
+        spdlog::shutdown();
+    }
+}
@@ -0,0 +1,187 @@
+// StockTracker.DataService/src/MappedFile.cpp
+#include "MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace StockTracker {
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path, size_t size)
+        : file_path(path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + path + ": error " + std::to_string(GetLastError()));
+        }
+        file_handle = file;
+
+        LARGE_INTEGER existing{};
+        GetFileSizeEx(file, &existing);
+        length = std::max(size, static_cast<size_t>(existing.QuadPart));
+
+        try {
+            map();
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    // Mapping a larger size than the file extends it with zeros
+    void MappedFile::map() {
+        LARGE_INTEGER mapped{};
+        mapped.QuadPart = static_cast<LONGLONG>(length);
+        HANDLE mapping = CreateFileMappingA(file_handle, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(mapped.HighPart), mapped.LowPart, nullptr);
+        if (!mapping) {
+            throw std::runtime_error("Cannot map " + file_path + ": error " + std::to_string(GetLastError()));
+        }
+        mapping_handle = mapping;
+
+        base = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, length);
+        if (!base) {
+            DWORD error = GetLastError();
+            unmap();
+            throw std::runtime_error("Cannot map " + file_path + ": error " + std::to_string(error));
+        }
+    }
+
+    void MappedFile::resize(size_t size) {
+        // The file cannot be truncated while a mapping of it is open
+        unmap();
+        LARGE_INTEGER end{};
+        end.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFilePointerEx(file_handle, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file_handle)) {
+            DWORD error = GetLastError();
+            close();
+            throw std::runtime_error("Cannot size " + file_path + ": error " + std::to_string(error));
+        }
+        length = size;
+        try {
+            map();
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    void MappedFile::flush(size_t offset, size_t count) {
+        if (base && count > 0) {
+            FlushViewOfFile(data() + offset, count);
+        }
+    }
+
+    void MappedFile::unmap() {
+        if (base) {
+            UnmapViewOfFile(base);
+            base = nullptr;
+        }
+        if (mapping_handle) {
+            CloseHandle(mapping_handle);
+            mapping_handle = nullptr;
+        }
+    }
+
+    void MappedFile::close() {
+        unmap();
+        if (file_handle) {
+            CloseHandle(file_handle);
+            file_handle = nullptr;
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& path, size_t size)
+        : file_path(path)
+    {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+        }
+
+        struct stat info {};
+        ::fstat(fd, &info);
+        length = std::max(size, static_cast<size_t>(info.st_size));
+        if (static_cast<size_t>(info.st_size) < length && ::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            int error = errno;
+            close();
+            throw std::runtime_error("Cannot size " + path + ": " + std::strerror(error));
+        }
+
+        try {
+            map();
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    void MappedFile::map() {
+        base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            throw std::runtime_error("Cannot map " + file_path + ": " + std::strerror(errno));
+        }
+    }
+
+    void MappedFile::resize(size_t size) {
+        unmap();
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            int error = errno;
+            close();
+            throw std::runtime_error("Cannot size " + file_path + ": " + std::strerror(error));
+        }
+        length = size;
+        try {
+            map();
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    void MappedFile::flush(size_t offset, size_t count) {
+        if (base && count > 0) {
+            // msync wants a page-aligned start
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const size_t start = offset - offset % page;
+            ::msync(data() + start, count + (offset - start), MS_SYNC);
+        }
+    }
+
+    void MappedFile::unmap() {
+        if (base) {
+            ::munmap(base, length);
+            base = nullptr;
+        }
+    }
+
+    void MappedFile::close() {
+        unmap();
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+}
@@ -0,0 +1,234 @@
+// StockTracker.DataService/src/MessagePublisher.cpp
+#include "MessagePublisher.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    MessagePublisher::MessagePublisher(const MessagePublisherConfig& config)
+        : config(config)
+        , socket(zmq::socket_type::pub)
+    {
+        socket.bind(config.endpoint);
+
+        // Sized for a typical burst so steady-state queueing never reallocates
+        quotes.reserve(std::min<size_t>(config.queue_capacity, 4096));
+        quote_order.reserve(std::min<size_t>(config.queue_capacity, 4096));
+        publisher_thread = std::thread(&MessagePublisher::publishLoop, this);
+    }
+
+    MessagePublisher::~MessagePublisher() {
+        stop();
+    }
+
+    void MessagePublisher::send(Message message) {
+        enqueue(std::move(message));
+    }
+
+    void MessagePublisher::send(Message message, SymbolId symbol) {
+        enqueue(std::move(message), symbol);
+    }
+
+    // Control messages never wait for room: they are few, and must not be
+    // held up by a quote backlog
+    void MessagePublisher::enqueue(Message message, std::optional<SymbolId> symbol) {
+        {
+            std::lock_guard lock(queue_mutex);
+            if (stopping) {
+                return;
+            }
+
+            // Control messages are sent before quotes, so move the symbol's
+            // waiting quotes into the control queue first, oldest first
+            if (symbol) {
+                auto is_symbol = [&](const QueuedQuote& queued) { return queued.symbol == *symbol; };
+                if (std::any_of(quotes.begin(), quotes.end(), is_symbol)) {
+                    for (auto& queued : quotes) {
+                        if (is_symbol(queued)) {
+                            control.push_back(Pending{ std::move(queued.quote), queued.queued });
+                        }
+                    }
+                    quotes.erase(std::remove_if(quotes.begin(), quotes.end(), is_symbol), quotes.end());
+                }
+                if (*symbol < quote_slots.size() && quote_slots[*symbol].occupied) {
+                    auto& slot = quote_slots[*symbol];
+                    control.push_back(Pending{ std::move(slot.quote), slot.queued });
+                    slot.occupied = false;
+                    quote_order.erase(std::find(quote_order.begin(), quote_order.end(), *symbol));
+                }
+            }
+
+            control.push_back(Pending{ std::move(message), std::chrono::steady_clock::now() });
+        }
+        queue_ready.notify_one();
+    }
+
+    void MessagePublisher::sendQuote(SymbolId symbol, StockQuote quote) {
+        if (!config.conflate_quotes) {
+            size_t depth = 0;
+            {
+                std::unique_lock lock(queue_mutex);
+                queue_space.wait(lock, [this] { return stopping || quotes.size() < config.queue_capacity; });
+                if (stopping) {
+                    return;
+                }
+                quotes.push_back(QueuedQuote{ symbol, std::move(quote), std::chrono::steady_clock::now() });
+                depth = quotes.size();
+            }
+            queue_ready.notify_one();
+
+            if (depth > max_queue_depth.load(std::memory_order_relaxed)) {
+                max_queue_depth.store(depth, std::memory_order_relaxed);
+            }
+            return;
+        }
+
+        bool first = false;
+        {
+            std::lock_guard lock(queue_mutex);
+            if (stopping) {
+                return;
+            }
+
+            first = quote_order.empty();
+            if (symbol >= quote_slots.size()) {
+                quote_slots.resize(symbol + 1);  // First quote for this id only
+            }
+            auto& slot = quote_slots[symbol];
+            slot.quote = std::move(quote);
+            if (slot.occupied) {
+                ++conflated;
+            }
+            else {
+                slot.occupied = true;
+                slot.queued = std::chrono::steady_clock::now();
+                quote_order.push_back(symbol);
+            }
+        }
+
+        // Later quotes ride along with the flush the first one scheduled
+        if (first) {
+            queue_ready.notify_one();
+        }
+    }
+
+    void MessagePublisher::stop() {
+        {
+            std::lock_guard lock(queue_mutex);
+            stopping = true;
+        }
+        queue_ready.notify_all();
+        queue_space.notify_all();
+
+        if (publisher_thread.joinable()) {
+            publisher_thread.join();
+        }
+    }
+
+    MessagePublisherStats MessagePublisher::stats() const {
+        MessagePublisherStats s;
+        s.sent = sent.load();
+        s.wakeups = wakeups.load();
+        s.conflated = conflated.load();
+        s.max_queue_depth = max_queue_depth.load();
+        s.last_latency_us = last_latency_us.load();
+        s.max_latency_us = max_latency_us.load();
+        s.latency = latency.summary();
+        {
+            std::lock_guard lock(queue_mutex);
+            s.queue_depth = control.size() + quotes.size();
+            s.pending_quotes = quote_order.size();
+        }
+        return s;
+    }
+
+    void MessagePublisher::transmit(const Message& message, std::chrono::steady_clock::time_point queued) {
+        try {
+            socket.send(message);
+            ++sent;
+        }
+        catch (const std::exception& e) {
+            uint64_t suppressed = 0;
+            if (send_error_log.allow(suppressed)) {
+                spdlog::error("Failed to publish message: {} ({} similar errors suppressed)", e.what(), suppressed);
+            }
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - queued;
+        latency.record(elapsed);
+        double latency_us = std::chrono::duration<double, std::micro>(elapsed).count();
+        last_latency_us.store(latency_us, std::memory_order_relaxed);
+        if (latency_us > max_latency_us.load(std::memory_order_relaxed)) {
+            max_latency_us.store(latency_us, std::memory_order_relaxed);
+        }
+    }
+
+    void MessagePublisher::publishLoop() {
+        std::vector<Pending> control_batch;
+        std::vector<QueuedQuote> quote_batch;
+        quote_batch.reserve(quotes.capacity());
+        std::vector<PendingQuote> slot_batch;
+        slot_batch.reserve(quote_order.capacity());
+        auto next_quote_flush = std::chrono::steady_clock::now();
+
+        while (true) {
+            {
+                std::unique_lock lock(queue_mutex);
+                auto unconflated = [this] { return stopping || !control.empty() || !quotes.empty(); };
+                if (quote_order.empty()) {
+                    queue_ready.wait(lock, [&] { return unconflated() || !quote_order.empty(); });
+                }
+                if (!quote_order.empty()) {
+                    queue_ready.wait_until(lock, next_quote_flush, unconflated);
+                }
+
+                if (control.empty() && quotes.empty() && quote_order.empty() && stopping) {
+                    break;  // Fully drained
+                }
+                control_batch.swap(control);
+                quote_batch.swap(quotes);
+
+                const auto now = std::chrono::steady_clock::now();
+                if (!quote_order.empty() && (stopping || now >= next_quote_flush)) {
+                    // Move the quotes out and free their slots; the slots
+                    // themselves stay allocated for the next burst
+                    for (SymbolId id : quote_order) {
+                        auto& slot = quote_slots[id];
+                        slot_batch.push_back(PendingQuote{ std::move(slot.quote), slot.queued, true });
+                        slot.occupied = false;
+                    }
+                    quote_order.clear();
+                    next_quote_flush = now + config.conflation_interval;
+                }
+            }
+            queue_space.notify_all();
+            ++wakeups;
+
+            // Control messages first, then quotes: queued ones in order, or
+            // the freshest one per symbol when conflating
+            for (auto& pending : control_batch) {
+                if (auto* quote = std::get_if<StockQuote>(&pending.payload)) {
+                    transmit(Message::makeQuoteUpdate(*quote), pending.queued);
+                }
+                else {
+                    transmit(std::get<Message>(pending.payload), pending.queued);
+                }
+            }
+            control_batch.clear();
+
+            for (auto& pending : quote_batch) {
+                transmit(Message::makeQuoteUpdate(pending.quote), pending.queued);
+            }
+            quote_batch.clear();
+
+            for (auto& pending : slot_batch) {
+                transmit(Message::makeQuoteUpdate(pending.quote), pending.queued);
+            }
+            slot_batch.clear();
+        }
+
+        auto s = stats();
+        spdlog::info("Publisher stopped: {} messages in {} wakeups, {} quotes conflated, max queue depth {}, max latency {:.1f}us",
+            s.sent, s.wakeups, s.conflated, s.max_queue_depth, s.max_latency_us);
+    }
+}
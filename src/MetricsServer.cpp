@@ -0,0 +1,112 @@
+// StockTracker.DataService/src/MetricsServer.cpp
+#include "MetricsServer.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+
+namespace StockTracker {
+
+    MetricsServer::MetricsServer(const MetricsServerConfig& config, Handler handler)
+        : config(config)
+        , handler(std::move(handler))
+        , context(1)
+        , socket(context, zmq::socket_type::stream)
+    {
+        socket.set(zmq::sockopt::linger, 0);
+        socket.bind(config.endpoint);
+        spdlog::info("Metrics server bound to {}", config.endpoint);
+
+        server_thread = std::thread(&MetricsServer::serve, this);
+    }
+
+    MetricsServer::~MetricsServer() {
+        stop();
+    }
+
+    void MetricsServer::stop() {
+        running = false;
+        if (server_thread.joinable()) {
+            server_thread.join();
+        }
+    }
+
+    void MetricsServer::serve() {
+        // Poll with a timeout so stop() is noticed promptly
+        zmq::pollitem_t items[] = { { socket.handle(), 0, ZMQ_POLLIN, 0 } };
+
+        while (running) {
+            try {
+                zmq::poll(items, 1, std::chrono::milliseconds(100));
+                if (items[0].revents & ZMQ_POLLIN) {
+                    handleOne();
+                }
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Metrics server error: {}", e.what());
+            }
+        }
+    }
+
+    // STREAM frames: [routing id][bytes]. An empty payload marks a peer
+    // connecting or disconnecting. A request may arrive in several pieces,
+    // so bytes are collected until the blank line that ends the headers.
+    void MetricsServer::handleOne() {
+        zmq::message_t id;
+        zmq::message_t data;
+        if (!socket.recv(id, zmq::recv_flags::dontwait) || !socket.recv(data)) {
+            return;
+        }
+
+        std::string peer = id.to_string();
+        if (data.size() == 0) {
+            partial.erase(peer);
+            return;
+        }
+
+        std::string& request = partial[peer];
+        request.append(data.data<char>(), data.size());
+        size_t end = request.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            if (request.size() > max_request_bytes) {
+                reply(peer, "431 Request Header Fields Too Large", "");
+            }
+            return;
+        }
+
+        std::string line = request.substr(0, request.find("\r\n"));
+        if (line.rfind("GET ", 0) != 0) {
+            reply(peer, "405 Method Not Allowed", "");
+        }
+        else if (line.rfind("GET /metrics ", 0) != 0 && line != "GET /metrics") {
+            reply(peer, "404 Not Found", "");
+        }
+        else {
+            std::string body;
+            try {
+                body = handler();
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Metrics handler failed: {}", e.what());
+                reply(peer, "500 Internal Server Error", "");
+                return;
+            }
+            reply(peer, "200 OK", body);
+        }
+    }
+
+    // Sends one response, then closes the connection (an empty frame to the
+    // peer), which also tells HTTP/1.0 clients where the body ends
+    void MetricsServer::reply(const std::string& peer, const char* status, const std::string& body) {
+        partial.erase(peer);
+
+        std::string response = std::string("HTTP/1.0 ") + status + "\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: close\r\n"
+            "\r\n" + body;
+
+        socket.send(zmq::buffer(peer), zmq::send_flags::sndmore);
+        socket.send(zmq::buffer(response), zmq::send_flags::none);
+        socket.send(zmq::buffer(peer), zmq::send_flags::sndmore);
+        socket.send(zmq::buffer(std::string()), zmq::send_flags::none);
+    }
+}
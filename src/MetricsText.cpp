@@ -0,0 +1,44 @@
+// StockTracker.DataService/src/MetricsText.cpp
+#include "MetricsText.h"
+#include <iterator>
+
+namespace StockTracker {
+
+    namespace {
+        double seconds(uint64_t ns) {
+            return static_cast<double>(ns) / 1e9;
+        }
+    }
+
+    void MetricsText::header(const char* name, const char* help, const char* type) {
+        fmt::format_to(std::back_inserter(out), "# HELP stocktracker_{} {}\n# TYPE stocktracker_{} {}\n",
+            name, help, name, type);
+    }
+
+    void MetricsText::counter(const char* name, const char* help, uint64_t value) {
+        header(name, help, "counter");
+        fmt::format_to(std::back_inserter(out), "stocktracker_{} {}\n", name, value);
+    }
+
+    void MetricsText::gauge(const char* name, const char* help, double value) {
+        header(name, help, "gauge");
+        fmt::format_to(std::back_inserter(out), "stocktracker_{} {}\n", name, value);
+    }
+
+    void MetricsText::summary(const char* name, const char* help, const LatencySummary& latency) {
+        header(name, help, "summary");
+        auto it = std::back_inserter(out);
+        fmt::format_to(it, "stocktracker_{}{{quantile=\"0.5\"}} {:.9f}\n", name, seconds(latency.p50_ns));
+        fmt::format_to(it, "stocktracker_{}{{quantile=\"0.99\"}} {:.9f}\n", name, seconds(latency.p99_ns));
+        fmt::format_to(it, "stocktracker_{}{{quantile=\"0.999\"}} {:.9f}\n", name, seconds(latency.p999_ns));
+        fmt::format_to(it, "stocktracker_{}_sum {:.9f}\n", name, seconds(latency.sum_ns));
+        fmt::format_to(it, "stocktracker_{}_count {}\n", name, latency.count);
+
+        header(fmt::format("{}_max", name).c_str(), "Largest recorded value", "gauge");
+        fmt::format_to(it, "stocktracker_{}_max {:.9f}\n", name, seconds(latency.max_ns));
+    }
+
+    std::string MetricsText::str() const {
+        return fmt::to_string(out);
+    }
+}
@@ -1,63 +1,204 @@
 #include "MockData.h"
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 #include <spdlog/spdlog.h>
 
 namespace StockTracker {
 
-	MockDataProvider::MockDataProvider()
-		: stock_configs{
-			{"AAPL", {175.0, 0.002, 0.0001}},   // Stable, slight upward trend
-			{"MSFT", {320.0, 0.0015, 0.00012}}, // Very stable
-			{"GOOGL", {140.0, 0.0025, 0.00008}}, // More volatile
-			{"AMZN", {130.0, 0.003, 0.00015}},   // High volatility
-			{"META", {270.0, 0.0035, -0.00005}}  // High volatility, slight downtrend
+	namespace {
+		// splitmix64: tiny state, so every symbol can own a generator
+		uint64_t nextRandom(uint64_t& state) {
+			uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
 		}
-	{}
+	}
 
-	StockQuote MockDataProvider::generateQuote(const std::string& symbol) {
-		auto it = stock_configs.find(symbol);
+	MockDataProvider::MockDataProvider(SymbolTable& symbol_table, size_t stream_count,
+		const MockProviderConfig& config)
+		: symbol_table(symbol_table)
+	{
+		std::random_device entropy;
+		seed = config.seed != 0 ? config.seed : (static_cast<uint64_t>(entropy()) << 32) | entropy();
+		for (size_t i = 0; i < std::max<size_t>(stream_count, 1); ++i) {
+			streams.push_back(std::make_unique<Stream>());
+		}
 
-		// Couldn't find the symbol
-		if (it == stock_configs.end()) {
-			throw std::runtime_error("Invalid symbol: " + symbol);
+		addSymbol("AAPL", {175.0, 0.002, 0.0001});   // Stable, slight upward trend
+		addSymbol("MSFT", {320.0, 0.0015, 0.00012}); // Very stable
+		addSymbol("GOOGL", {140.0, 0.0025, 0.00008}); // More volatile
+		addSymbol("AMZN", {130.0, 0.003, 0.00015});   // High volatility
+		addSymbol("META", {270.0, 0.0035, -0.00005});  // High volatility, slight downtrend
+
+		if (config.synthetic.symbols > 0) {
+			std::mt19937_64 universe_rng(seed);
+			addSyntheticSymbols(config.synthetic, universe_rng);
+			spdlog::info("Mock provider: {} synthetic symbols (seed {})", config.synthetic.symbols, seed);
+		}
+	}
+
+	void MockDataProvider::addSyntheticSymbols(const SyntheticUniverseConfig& config, std::mt19937_64& rng) {
+		std::uniform_real_distribution<double> price(config.min_price, std::max(config.min_price, config.max_price));
+		std::uniform_real_distribution<double> volatility(config.min_volatility,
+			std::max(config.min_volatility, config.max_volatility));
+		std::normal_distribution<double> trend(config.trend_mean, std::max(config.trend_stddev, 0.0));
+
+		for (size_t i = 0; i < config.symbols; ++i) {
+			// Drawn in a fixed order so a seed always yields the same universe
+			StockConfig stock;
+			stock.base_price = price(rng);
+			stock.volatility = volatility(rng);
+			stock.trend = trend(rng);
+			addSymbol(fmt::format("SYN{:06}", i), stock);
+		}
+	}
+
+	void MockDataProvider::addSymbol(const std::string& symbol, const StockConfig& config) {
+		SymbolId id = symbol_table.intern(symbol);
+		if (id >= known.size()) {
+			known.resize(id + 1, 0);
+			base_prices.resize(id + 1, 0.0);
+			volatilities.resize(id + 1, 0.0);
+			trends.resize(id + 1, 0.0);
+			last_prices.resize(id + 1, 0.0);
+			rng_states.resize(id + 1, 0);
+		}
+
+		// Golden-ratio spacing keeps neighbouring ids' sequences apart
+		uint64_t state = seed + id * 0x9e3779b97f4a7c15ull;
+		rng_states[id] = nextRandom(state);
+
+		known[id] = 1;
+		base_prices[id] = config.base_price;
+		volatilities[id] = config.volatility;
+		trends[id] = config.trend;
+		available.push_back(id);
+	}
+
+	// Box-Muller on two uniforms from each symbol's own generator, keeping
+	// the cosine normal only so no sample is shared between symbols. The
+	// uniforms are drawn first, then the transform runs as a separate
+	// branch-free loop the compiler can vectorize.
+	void MockDataProvider::fillNormals(Stream& stream, const SymbolId* ids, size_t count) {
+		constexpr double two_pi = 6.283185307179586;
+		constexpr double to_unit = 1.0 / 9007199254740992.0;  // 2^-53
+
+		auto& uniforms = stream.uniforms;
+		auto& normals = stream.normals;
+		uniforms.resize(count * 2);
+		normals.resize(count);
+
+		// Uniforms in (0, 1]: u1 must not be zero for the log
+		for (size_t i = 0; i < count; ++i) {
+			uint64_t& state = rng_states[ids[i]];
+			uniforms[2 * i] = (static_cast<double>(nextRandom(state) >> 11) + 1.0) * to_unit;
+			uniforms[2 * i + 1] = (static_cast<double>(nextRandom(state) >> 11) + 1.0) * to_unit;
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			double radius = std::sqrt(-2.0 * std::log(uniforms[2 * i]));
+			normals[i] = radius * std::cos(two_pi * uniforms[2 * i + 1]);
+		}
+	}
+
+	void MockDataProvider::generatePrices(Stream& stream, const SymbolId* ids, size_t count,
+		double* prices, double* change_percents) {
+		fillNormals(stream, ids, count);
+		const auto& normals = stream.normals;
+
+		for (size_t i = 0; i < count; ++i) {
+			const SymbolId id = ids[i];
+			double last_price = last_prices[id];
+
+			// Initialize last price if first time
+			if (last_price == 0.0) {
+				last_price = base_prices[id];
+			}
+
+			// generate random walk with drift
+			double change = trends[id] + volatilities[id] * normals[i];
+			double new_price = last_price * (1.0 + change);
+
+			// Calculate percent change
+			change_percents[i] = ((new_price - last_price) / last_price) * 100;
+			prices[i] = new_price;
+			last_prices[id] = new_price;
 		}
+	}
 
-		spdlog::info("Generating quote for {}", symbol);
+	void MockDataProvider::generateTicks(Stream& stream, const SymbolId* ids, size_t count, std::vector<Tick>& out) {
+		stream.batch_prices.resize(count);
+		stream.batch_changes.resize(count);
+		generatePrices(stream, ids, count, stream.batch_prices.data(), stream.batch_changes.data());
 
-		const auto& config = it->second;
-		auto last_price = last_prices[symbol];
+		const auto now = std::chrono::system_clock::now();
+		for (size_t i = 0; i < count; ++i) {
+			out.push_back(Tick{ ids[i], stream.batch_prices[i], stream.batch_changes[i], now });
+		}
+	}
 
-		// Initialize last price if first time
-		if (last_price == 0.0) {
-			last_price = config.base_price;
+	void MockDataProvider::generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) {
+		if (count == 0) {
+			return;
 		}
 
-		// generate random walk with drift
-		std::normal_distribution<> dist(config.trend, config.volatility);
-		double change = dist(rng);
-		double new_price = last_price * (1.0 + change);
+		const size_t stream = streamOf(ids[0]);
+		if (std::all_of(ids, ids + count, [&](SymbolId id) { return streamOf(id) == stream; })) {
+			auto& owner = *streams[stream];
+			std::lock_guard lock(owner.mutex);
+			generateTicks(owner, ids, count, out);
+			return;
+		}
 
-		// Calculate percent change
-		double percent_change = ((new_price - last_price) / last_price) * 100;
-		last_price = new_price;
+		for (size_t i = 0; i < count; ++i) {
+			auto& owner = streamFor(ids[i]);
+			std::lock_guard lock(owner.mutex);
+			generateTicks(owner, &ids[i], 1, out);
+		}
+	}
+
+	StockQuote MockDataProvider::generateQuote(const std::string& symbol) {
+		auto id = symbol_table.find(symbol);
+
+		// Couldn't find the symbol
+		if (!id || !isValidSymbol(*id)) {
+			throw std::runtime_error("Invalid symbol: " + symbol);
+		}
+
+		SPDLOG_TRACE("Generating quote for {}", symbol);
+
+		double price = 0.0;
+		double percent_change = 0.0;
+		{
+			auto& owner = streamFor(*id);
+			std::lock_guard lock(owner.mutex);
+			generatePrices(owner, &*id, 1, &price, &percent_change);
+		}
 
 		// Create a quote with the new price.
-		auto quote = StockQuote::create(symbol, new_price);
+		auto quote = StockQuote::create(symbol, price);
 		quote.change_percent = percent_change;
 		return quote;
 		
 	}
 
 	bool MockDataProvider::isValidSymbol(const std::string& symbol) const {
-		return stock_configs.find(symbol) != stock_configs.end();
+		auto id = symbol_table.find(symbol);
+		return id && isValidSymbol(*id);
+	}
+
+	bool MockDataProvider::isValidSymbol(SymbolId id) const {
+		return id < known.size() && known[id] != 0;
 	}
 
 	std::vector<std::string> MockDataProvider::getAvailableSymbols() const {
 		std::vector<std::string> symbols;
-		symbols.reserve(stock_configs.size());
+		symbols.reserve(available.size());
 
-		for (const auto& [symbol, _] : stock_configs) {
-			symbols.push_back(symbol);
+		for (SymbolId id : available) {
+			symbols.push_back(symbol_table.name(id));
 		}
 
 		return symbols;
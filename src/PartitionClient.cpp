@@ -0,0 +1,65 @@
+// StockTracker.DataService/src/PartitionClient.cpp
+#include "PartitionClient.h"
+#include <spdlog/spdlog.h>
+
+namespace StockTracker {
+
+    PartitionClient::PartitionClient(std::chrono::milliseconds timeout)
+        : context(1)
+        , timeout(timeout)
+    {
+    }
+
+    std::vector<std::optional<std::string>> PartitionClient::requestAll(const std::vector<std::string>& endpoints,
+        const std::string& request) {
+        // Fresh DEALER sockets per call, so a late reply to an earlier call
+        // can never be taken for this one's
+        std::vector<zmq::socket_t> sockets;
+        std::vector<zmq::pollitem_t> items;
+        sockets.reserve(endpoints.size());
+        for (const auto& endpoint : endpoints) {
+            sockets.emplace_back(context, zmq::socket_type::dealer);
+            auto& socket = sockets.back();
+            socket.set(zmq::sockopt::linger, 0);
+            socket.connect(endpoint);
+            // An empty delimiter, as REQ would send, ahead of the request
+            socket.send(zmq::message_t(), zmq::send_flags::sndmore);
+            socket.send(zmq::buffer(request), zmq::send_flags::none);
+        }
+        for (auto& socket : sockets) {
+            items.push_back({ socket.handle(), 0, ZMQ_POLLIN, 0 });
+        }
+
+        std::vector<std::optional<std::string>> replies(endpoints.size());
+        size_t pending = endpoints.size();
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (pending > 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0) {
+                break;
+            }
+            zmq::poll(items.data(), items.size(), left);
+
+            for (size_t i = 0; i < sockets.size(); ++i) {
+                if (replies[i] || !(items[i].revents & ZMQ_POLLIN)) {
+                    continue;
+                }
+                // [empty delimiter][reply]
+                zmq::message_t frame;
+                while (sockets[i].recv(frame, zmq::recv_flags::dontwait) && frame.more()) {
+                }
+                replies[i] = frame.to_string();
+                items[i].events = 0;  // Done with this one
+                --pending;
+            }
+        }
+
+        for (size_t i = 0; i < endpoints.size(); ++i) {
+            if (!replies[i]) {
+                spdlog::warn("No reply from partition member at {} to {}", endpoints[i], request);
+            }
+        }
+        return replies;
+    }
+}
@@ -0,0 +1,94 @@
+// StockTracker.DataService/src/PriceHistoryCache.cpp
+#include "PriceHistoryCache.h"
+
+namespace StockTracker {
+
+    PriceHistoryCache::PriceHistoryCache(const PriceHistoryCacheConfig& config)
+        : config(config)
+    {}
+
+    void PriceHistoryCache::record(SymbolId symbol, double price, std::chrono::system_clock::time_point timestamp) {
+        if (!config.enabled || config.depth == 0) {
+            return;
+        }
+
+        std::lock_guard lock(mutex);
+        if (symbol >= rings.size()) {
+            rings.resize(symbol + 1);
+        }
+
+        auto& ring = rings[symbol];
+        if (ring.points.empty()) {
+            if ((symbols + 1) * ringBytes() > config.max_bytes) {
+                return;  // Over budget: this symbol's history stays in SQLite only
+            }
+            ring.points.resize(config.depth);
+            ++symbols;
+            // A symbol first seen now has no older history from this run;
+            // whether SQLite has any is found out on the first read
+        }
+
+        const size_t capacity = ring.points.size();
+        if (ring.count < capacity) {
+            ring.points[(ring.head + ring.count) % capacity] = Point{ timestamp, price };
+            ++ring.count;
+            ++points;
+        }
+        else {
+            // Overwrite the oldest point; it now only exists in SQLite
+            ring.points[ring.head] = Point{ timestamp, price };
+            ring.head = (ring.head + 1) % capacity;
+            ring.complete = false;
+        }
+    }
+
+    bool PriceHistoryCache::read(SymbolId symbol, std::vector<Point>& out) const {
+        std::lock_guard lock(mutex);
+        if (symbol >= rings.size() || rings[symbol].count == 0) {
+            ++misses;
+            return false;
+        }
+
+        const auto& ring = rings[symbol];
+        const size_t capacity = ring.points.size();
+        out.reserve(out.size() + ring.count);
+        for (size_t i = 0; i < ring.count; ++i) {
+            out.push_back(ring.points[(ring.head + i) % capacity]);
+        }
+
+        if (ring.complete) {
+            ++hits;
+        }
+        else {
+            ++partial_hits;
+        }
+        return ring.complete;
+    }
+
+    void PriceHistoryCache::markComplete(SymbolId symbol, std::chrono::system_clock::time_point oldest) {
+        std::lock_guard lock(mutex);
+        if (symbol >= rings.size() || rings[symbol].count == 0) {
+            return;
+        }
+
+        // Only valid if nothing was evicted since the caller's read()
+        auto& ring = rings[symbol];
+        if (ring.points[ring.head].timestamp == oldest) {
+            ring.complete = true;
+        }
+    }
+
+    PriceHistoryCacheStats PriceHistoryCache::stats() const {
+        PriceHistoryCacheStats s;
+        {
+            std::lock_guard lock(mutex);
+            s.symbols = symbols;
+            s.points = points;
+            s.bytes = symbols * ringBytes();
+        }
+        s.hits = hits.load();
+        s.partial_hits = partial_hits.load();
+        s.misses = misses.load();
+        return s;
+    }
+}
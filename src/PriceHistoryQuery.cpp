@@ -0,0 +1,96 @@
+// StockTracker.DataService/src/PriceHistoryQuery.cpp
+#include "PriceHistoryQuery.h"
+#include <algorithm>
+
+namespace StockTracker {
+
+    std::optional<BarResolution> parseBarResolution(const std::string& text) {
+        for (auto resolution : { BarResolution::Raw, BarResolution::Second, BarResolution::Minute, BarResolution::Hour }) {
+            if (text == toString(resolution)) {
+                return resolution;
+            }
+        }
+        return std::nullopt;
+    }
+
+    const char* toString(BarResolution resolution) {
+        switch (resolution) {
+        case BarResolution::Second: return "1s";
+        case BarResolution::Minute: return "1m";
+        case BarResolution::Hour: return "1h";
+        default: return "raw";
+        }
+    }
+
+    std::chrono::seconds barWidth(BarResolution resolution) {
+        switch (resolution) {
+        case BarResolution::Second: return std::chrono::seconds(1);
+        case BarResolution::Minute: return std::chrono::minutes(1);
+        case BarResolution::Hour: return std::chrono::hours(1);
+        default: return std::chrono::seconds(0);
+        }
+    }
+
+    namespace {
+        void extend(PriceBar& bar, double price) {
+            bar.high = std::max(bar.high, price);
+            bar.low = std::min(bar.low, price);
+            bar.close = price;
+            ++bar.count;
+        }
+
+        void merge(PriceBar& into, const PriceBar& next) {
+            into.high = std::max(into.high, next.high);
+            into.low = std::min(into.low, next.low);
+            into.close = next.close;
+            into.count += next.count;
+        }
+    }
+
+    std::vector<PriceBar> aggregateBars(const std::vector<PriceHistoryCache::Point>& points,
+        const PriceHistoryQuery& query) {
+        std::vector<PriceBar> bars;
+        const auto width = barWidth(query.resolution);
+
+        for (const auto& point : points) {
+            if ((query.from && point.timestamp < *query.from) || (query.to && point.timestamp >= *query.to)) {
+                continue;
+            }
+
+            auto start = point.timestamp;
+            if (width.count() != 0) {
+                auto since_epoch = point.timestamp.time_since_epoch();
+                start = std::chrono::system_clock::time_point(since_epoch - since_epoch % width);
+            }
+
+            if (width.count() != 0 && !bars.empty() && bars.back().start == start) {
+                extend(bars.back(), point.price);
+            }
+            else {
+                bars.push_back(PriceBar{ start, point.price, point.price, point.price, point.price, 1 });
+            }
+        }
+
+        return fitBars(std::move(bars), query.max_points);
+    }
+
+    std::vector<PriceBar> fitBars(std::vector<PriceBar> bars, size_t max_points) {
+        if (max_points == 0 || bars.size() <= max_points) {
+            return bars;
+        }
+
+        // Merge every `factor` neighbouring bars into one
+        const size_t factor = (bars.size() + max_points - 1) / max_points;
+        std::vector<PriceBar> merged;
+        merged.reserve(max_points);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            if (i % factor == 0) {
+                merged.push_back(bars[i]);
+            }
+            else {
+                merge(merged.back(), bars[i]);
+            }
+        }
+        return merged;
+    }
+}
@@ -0,0 +1,107 @@
+// StockTracker.DataService/src/PriceStore.cpp
+#include "PriceStore.h"
+#include <spdlog/spdlog.h>
+
+namespace StockTracker {
+
+    namespace {
+        const char* const InsertTick = "INSERT INTO price_ticks (symbol, timestamp_ms, price) VALUES (?, ?, ?)";
+
+        const char* const SelectTicks = "SELECT timestamp_ms, price FROM price_ticks "
+            "WHERE symbol = ? AND timestamp_ms >= ? AND timestamp_ms < ? ORDER BY timestamp_ms";
+
+        int64_t toMillis(PriceStore::TimePoint time) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+        }
+
+        PriceStore::TimePoint fromMillis(int64_t millis) {
+            return PriceStore::TimePoint(std::chrono::milliseconds(millis));
+        }
+    }
+
+    SqlitePriceStore::SqlitePriceStore(const std::string& path, const DatabaseTuningConfig& tuning,
+        DatabaseMutex& database_mutex, const SymbolTable& symbol_table)
+        : symbol_table(symbol_table)
+        , database_mutex(database_mutex)
+        , connection(path, tuning)
+    {
+        std::lock_guard db_lock(database_mutex);
+        connection.exec("CREATE TABLE IF NOT EXISTS price_ticks ("
+            "symbol TEXT NOT NULL, timestamp_ms INTEGER NOT NULL, price REAL NOT NULL)");
+        if (tuning.index_price_history) {
+            connection.exec("CREATE INDEX IF NOT EXISTS idx_price_ticks_symbol_timestamp "
+                "ON price_ticks (symbol, timestamp_ms)");
+        }
+    }
+
+    // One transaction per batch: a single commit (and sync) however many
+    // rows, so the database mutex is held only briefly. A row that fails is
+    // logged and skipped; a failed commit loses the batch.
+    size_t SqlitePriceStore::append(const std::vector<Tick>& ticks) {
+        if (ticks.empty()) {
+            return 0;
+        }
+
+        size_t saved = 0;
+        std::scoped_lock lock(database_mutex, mutex);
+        try {
+            connection.exec("BEGIN");
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to start a price batch: {}", e.what());
+            return 0;
+        }
+
+        for (const auto& tick : ticks) {
+            const auto& name = symbol_table.name(tick.symbol);
+            sqlite3_stmt* insert = connection.statement(InsertTick);
+            sqlite3_bind_text(insert, 1, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+            sqlite3_bind_int64(insert, 2, toMillis(tick.timestamp));
+            sqlite3_bind_double(insert, 3, tick.price);
+
+            if (sqlite3_step(insert) == SQLITE_DONE) {
+                ++saved;
+                continue;
+            }
+
+            uint64_t suppressed = 0;
+            if (save_error_log.allow(suppressed)) {
+                spdlog::error("Failed to persist price for {}: {} ({} similar errors suppressed)",
+                    name, sqlite3_errmsg(connection.handle()), suppressed);
+            }
+        }
+
+        try {
+            connection.exec("COMMIT");
+        }
+        catch (const std::exception& e) {
+            sqlite3_exec(connection.handle(), "ROLLBACK", nullptr, nullptr, nullptr);
+            spdlog::error("Failed to commit {} prices: {}", saved, e.what());
+            return 0;
+        }
+        return saved;
+    }
+
+    std::vector<PriceHistoryCache::Point> SqlitePriceStore::history(SymbolId symbol, TimePoint from, TimePoint to) {
+        std::vector<PriceHistoryCache::Point> points;
+        const auto& name = symbol_table.name(symbol);
+
+        std::lock_guard lock(mutex);
+        sqlite3_stmt* select = connection.statement(SelectTicks);
+        sqlite3_bind_text(select, 1, name.c_str(), static_cast<int>(name.size()), SQLITE_STATIC);
+        sqlite3_bind_int64(select, 2, toMillis(from));
+        sqlite3_bind_int64(select, 3, toMillis(to));
+
+        int rc;
+        while ((rc = sqlite3_step(select)) == SQLITE_ROW) {
+            points.push_back(PriceHistoryCache::Point{ fromMillis(sqlite3_column_int64(select, 0)),
+                sqlite3_column_double(select, 1) });
+        }
+
+        if (rc != SQLITE_DONE) {
+            spdlog::error("Failed to load prices for {}: {}", name, sqlite3_errmsg(connection.handle()));
+        }
+        sqlite3_reset(select);
+        return points;
+    }
+}
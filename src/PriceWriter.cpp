@@ -0,0 +1,201 @@
+// StockTracker.DataService/src/PriceWriter.cpp
+#include "PriceWriter.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    PriceWriter::PriceWriter(PriceStore& price_store, BarStore& bar_store, const PriceWriterConfig& config)
+        : price_store(price_store)
+        , bar_store(bar_store)
+        , config(config)
+        , ring(std::max<size_t>(config.queue_capacity, 1))
+    {
+        writer_thread = std::thread(&PriceWriter::writerLoop, this);
+    }
+
+    PriceWriter::~PriceWriter() {
+        stop();
+    }
+
+    bool PriceWriter::enqueue(const Tick& tick) {
+        bool dropped_one = false;
+        size_t depth = 0;
+        {
+            std::unique_lock lock(queue_mutex);
+            if (stopping) {
+                ++dropped;
+                return false;
+            }
+
+            if (queued >= ring.size()) {
+                switch (config.overflow_policy) {
+                case OverflowPolicy::Block:
+                    queue_space.wait(lock, [this] {
+                        return stopping || queued < ring.size();
+                    });
+                    if (stopping) {
+                        ++dropped;
+                        return false;
+                    }
+                    break;
+
+                case OverflowPolicy::DropNewest:
+                    ++dropped;
+                    return false;
+
+                case OverflowPolicy::DropOldest:
+                    ring_head = (ring_head + 1) % ring.size();
+                    --queued;
+                    dropped_one = true;
+                    break;
+                }
+            }
+
+            ring[(ring_head + queued) % ring.size()] = tick;
+            depth = ++queued;
+        }
+
+        ++enqueued;
+        if (dropped_one) {
+            ++dropped;
+        }
+
+        if (depth > max_queue_depth.load(std::memory_order_relaxed)) {
+            max_queue_depth.store(depth, std::memory_order_relaxed);
+        }
+
+        // Only wake the writer early once a full batch is waiting; otherwise
+        // it picks the quote up on its next timed flush.
+        if (depth >= config.max_batch_size) {
+            queue_ready.notify_one();
+        }
+        return true;
+    }
+
+    void PriceWriter::enqueue(const RollupBar& bar) {
+        std::lock_guard lock(queue_mutex);
+        pending_bars.push_back(bar);
+    }
+
+    void PriceWriter::stop() {
+        {
+            std::lock_guard lock(queue_mutex);
+            stopping = true;
+        }
+        queue_ready.notify_all();
+        queue_space.notify_all();
+
+        if (writer_thread.joinable()) {
+            writer_thread.join();
+        }
+    }
+
+    PriceWriterStats PriceWriter::stats() const {
+        PriceWriterStats s;
+        s.enqueued = enqueued.load();
+        s.written = written.load();
+        s.dropped = dropped.load();
+        s.batches = batches.load();
+        s.bars_written = bars_written.load();
+        s.max_queue_depth = max_queue_depth.load();
+        s.last_flush_ms = last_flush_ms.load();
+        s.max_flush_ms = max_flush_ms.load();
+        s.flush = flush_latency.summary();
+        {
+            std::lock_guard lock(queue_mutex);
+            s.queue_depth = queued;
+        }
+        return s;
+    }
+
+    void PriceWriter::writerLoop() {
+        std::vector<Tick> batch;
+        batch.reserve(config.max_batch_size);
+        std::vector<RollupBar> bars;
+        uint64_t reported_drops = 0;
+
+        while (true) {
+            bool done = false;
+            {
+                std::unique_lock lock(queue_mutex);
+                queue_ready.wait_for(lock, config.flush_interval, [this] {
+                    return stopping || queued >= config.max_batch_size;
+                });
+
+                size_t count = std::min(queued, config.max_batch_size);
+                for (size_t i = 0; i < count; ++i) {
+                    batch.push_back(ring[(ring_head + i) % ring.size()]);
+                }
+                ring_head = (ring_head + count) % ring.size();
+                queued -= count;
+                bars.swap(pending_bars);
+
+                // Keep draining after stop() until the queue is empty
+                done = stopping && queued == 0 && pending_bars.empty();
+            }
+            queue_space.notify_all();
+
+            if (!batch.empty()) {
+                writeBatch(batch);
+                batch.clear();
+            }
+
+            if (!bars.empty()) {
+                writeBars(bars);
+                bars.clear();
+            }
+
+            uint64_t total_drops = dropped.load();
+            if (total_drops != reported_drops) {
+                spdlog::warn("Price writer dropped {} quotes (queue full)", total_drops - reported_drops);
+                reported_drops = total_drops;
+            }
+
+            if (done) {
+                break;
+            }
+        }
+
+        auto s = stats();
+        spdlog::info("Price writer stopped: {} written in {} batches, {} bars, {} dropped, max queue depth {}, max flush {:.2f}ms",
+            s.written, s.batches, s.bars_written, s.dropped, s.max_queue_depth, s.max_flush_ms);
+    }
+
+    void PriceWriter::writeBatch(std::vector<Tick>& batch) {
+        auto start = std::chrono::steady_clock::now();
+
+        size_t saved = 0;
+        try {
+            saved = price_store.append(batch);
+        }
+        catch (const std::exception& e) {
+            uint64_t suppressed = 0;
+            if (save_error_log.allow(suppressed)) {
+                spdlog::error("Failed to persist {} prices: {} ({} similar errors suppressed)",
+                    batch.size(), e.what(), suppressed);
+            }
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        flush_latency.record(elapsed);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+
+        written += saved;
+        ++batches;
+        last_flush_ms.store(elapsed_ms, std::memory_order_relaxed);
+        if (elapsed_ms > max_flush_ms.load(std::memory_order_relaxed)) {
+            max_flush_ms.store(elapsed_ms, std::memory_order_relaxed);
+        }
+    }
+
+    void PriceWriter::writeBars(const std::vector<RollupBar>& bars) {
+        try {
+            bar_store.save(bars);
+            bars_written += bars.size();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to persist {} rollup bars: {}", bars.size(), e.what());
+        }
+    }
+}
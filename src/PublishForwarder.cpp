@@ -0,0 +1,85 @@
+// StockTracker.DataService/src/PublishForwarder.cpp
+#include "PublishForwarder.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+
+namespace StockTracker {
+
+    PublishForwarder::PublishForwarder(const std::vector<Route>& routes)
+        : context(1)
+    {
+        for (const auto& route : routes) {
+            if (route.backends.empty()) {
+                continue;
+            }
+            auto link = std::make_unique<Link>(Link{
+                zmq::socket_t(context, zmq::socket_type::xpub),
+                zmq::socket_t(context, zmq::socket_type::xsub) });
+            link->frontend.set(zmq::sockopt::linger, 0);
+            // Pass on repeat subscribes too; the quote feed resends its
+            // dictionary for each new binary listener
+            link->frontend.set(zmq::sockopt::xpub_verbose, 1);
+            link->backend.set(zmq::sockopt::linger, 0);
+            link->frontend.bind(route.frontend);
+            for (const auto& backend : route.backends) {
+                link->backend.connect(backend);
+            }
+            spdlog::info("Forwarding {} publishers to {}", route.backends.size(), route.frontend);
+            links.push_back(std::move(link));
+        }
+
+        forward_thread = std::thread(&PublishForwarder::forward, this);
+    }
+
+    PublishForwarder::~PublishForwarder() {
+        stop();
+    }
+
+    void PublishForwarder::stop() {
+        running = false;
+        if (forward_thread.joinable()) {
+            forward_thread.join();
+        }
+    }
+
+    void PublishForwarder::forward() {
+        // Two items per link: [frontend, backend]
+        std::vector<zmq::pollitem_t> items;
+        for (auto& link : links) {
+            items.push_back({ link->frontend.handle(), 0, ZMQ_POLLIN, 0 });
+            items.push_back({ link->backend.handle(), 0, ZMQ_POLLIN, 0 });
+        }
+
+        while (running && !items.empty()) {
+            try {
+                zmq::poll(items.data(), items.size(), std::chrono::milliseconds(100));
+                for (size_t i = 0; i < links.size(); ++i) {
+                    // Subscriptions go upstream, messages downstream
+                    if (items[2 * i].revents & ZMQ_POLLIN) {
+                        relay(links[i]->frontend, links[i]->backend);
+                    }
+                    if (items[2 * i + 1].revents & ZMQ_POLLIN) {
+                        relay(links[i]->backend, links[i]->frontend);
+                    }
+                }
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Publish forwarder error: {}", e.what());
+            }
+        }
+    }
+
+    // Moves every complete multipart message waiting on `from`
+    void PublishForwarder::relay(zmq::socket_t& from, zmq::socket_t& to) {
+        zmq::message_t frame;
+        while (from.recv(frame, zmq::recv_flags::dontwait)) {
+            bool more = frame.more();
+            to.send(frame, more ? zmq::send_flags::sndmore : zmq::send_flags::none);
+            while (more) {
+                (void)from.recv(frame, zmq::recv_flags::none);
+                more = frame.more();
+                to.send(frame, more ? zmq::send_flags::sndmore : zmq::send_flags::none);
+            }
+        }
+    }
+}
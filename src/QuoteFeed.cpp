@@ -0,0 +1,330 @@
+// StockTracker.DataService/src/QuoteFeed.cpp
+#include "QuoteFeed.h"
+#include "StockTracker/CurrencyService.h"
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    QuoteFeed::QuoteFeed(FxRateCache& fx_rates, const SymbolTable& symbol_table, const QuoteFeedConfig& config,
+        uint32_t member)
+        : fx_rates(fx_rates)
+        , symbol_table(symbol_table)
+        , config(config)
+        , context(1)
+        , socket(context, zmq::socket_type::xpub)
+        , member(member)
+    {
+        if (member >= QuoteWire::MaxMembers) {
+            throw std::runtime_error(fmt::format("Quote feed supports at most {} partition members",
+                QuoteWire::MaxMembers));
+        }
+
+        socket.set(zmq::sockopt::sndhwm, config.send_high_water_mark);
+        socket.set(zmq::sockopt::linger, 0);
+        // Refuse, rather than silently drop, at the high water mark so a
+        // failed dictionary send can be retried
+        socket.set(zmq::sockopt::xpub_nodrop, 1);
+        // Report every subscribe, not just the first per topic, so a second
+        // binary consumer still triggers a dictionary resend
+        socket.set(zmq::sockopt::xpub_verbose, 1);
+        socket.bind(config.endpoint);
+        spdlog::info("Quote feed bound to {}", config.endpoint);
+    }
+
+    // XPUB delivers subscription changes as messages: a 1 (subscribe) or
+    // 0 (unsubscribe) byte followed by the topic. With xpub_verbose every
+    // subscribe arrives, including repeats of an active topic, while only
+    // the last unsubscribe of a topic does; the set below is therefore
+    // exactly the topics someone is listening to.
+    bool QuoteFeed::readSubscriptions() {
+        bool changed = false;
+        zmq::message_t msg;
+        while (socket.recv(msg, zmq::recv_flags::dontwait)) {
+            if (msg.size() == 0) {
+                continue;
+            }
+
+            const auto* data = static_cast<const char*>(msg.data());
+            std::string subscription(data + 1, msg.size() - 1);
+            if (data[0] == 1) {
+                changed |= subscribed_topics.insert(subscription).second;
+                // Every binary or dictionary listener, even one joining a
+                // topic that is already active, needs the full id table
+                if (subscription.empty() || subscription[0] == QuoteWire::BinaryQuoteTopicPrefix[0]
+                    || subscription[0] == QuoteWire::DictionaryTopic[0]) {
+                    resend_dictionary = true;
+                }
+            }
+            else if (data[0] == 0) {
+                changed |= subscribed_topics.erase(subscription) != 0;
+            }
+        }
+        return changed;
+    }
+
+    // Turn the raw subscription prefixes into per-currency interest for
+    // each format ("Q/" text shown; "B/" binary is the same):
+    //   ""                   -> every symbol in the base currency, all formats
+    //   "Q", "Q/"            -> every symbol in the base currency
+    //   "Q/EUR", "Q/EUR/"    -> every symbol in EUR
+    //   "Q/EUR/AA"           -> every symbol in EUR (partial symbol prefix)
+    //   "Q/EUR/AAPL/"        -> AAPL in EUR
+    // Symbols the service has never heard of are ignored.
+    // Batch topics ("QB/", "BB/") only resolve down to the currency.
+    void QuoteFeed::rebuildCurrencies() {
+        // Quotes already batched belong to the old currency layout
+        flushBatches();
+
+        std::unordered_map<std::string, CurrencyInterest> active;
+
+        for (const auto& subscription : subscribed_topics) {
+            for (auto format : { QuoteWire::Format::Text, QuoteWire::Format::Binary }) {
+                const std::string prefix(QuoteWire::batchTopicPrefix(format));
+                auto select = [format](CurrencyInterest& c) -> bool& {
+                    return format == QuoteWire::Format::Binary ? c.binary_batch : c.text_batch;
+                };
+
+                if (subscription.size() <= prefix.size()) {
+                    if (prefix.compare(0, subscription.size(), subscription) == 0) {
+                        select(active["USD"]) = true;
+                    }
+                    continue;
+                }
+                if (subscription.compare(0, prefix.size(), prefix) != 0) {
+                    continue;
+                }
+
+                std::string currency = subscription.substr(prefix.size(), 3);
+                if (CurrencyService::isValidCurrencyCode(currency)) {
+                    select(active[currency]) = true;
+                }
+            }
+
+            for (auto format : { QuoteWire::Format::Text, QuoteWire::Format::Binary }) {
+                const std::string prefix(QuoteWire::topicPrefix(format));
+                auto select = [format](CurrencyInterest& c) -> Interest& {
+                    return format == QuoteWire::Format::Binary ? c.binary : c.text;
+                };
+
+                if (subscription.size() <= prefix.size()) {
+                    if (prefix.compare(0, subscription.size(), subscription) == 0) {
+                        select(active["USD"]).all_symbols = true;
+                    }
+                    continue;
+                }
+                if (subscription.compare(0, prefix.size(), prefix) != 0) {
+                    continue;  // Not a quote topic in this format
+                }
+
+                auto rest = subscription.substr(prefix.size());
+                auto slash = rest.find('/');
+                std::string currency = rest.substr(0, slash);
+                if (!CurrencyService::isValidCurrencyCode(currency)) {
+                    continue;
+                }
+
+                auto& interest = select(active[currency]);
+                std::string symbol = slash == std::string::npos ? std::string() : rest.substr(slash + 1);
+                if (!symbol.empty() && symbol.back() == '/') {
+                    symbol.pop_back();
+                    if (auto id = symbol_table.find(symbol)) {
+                        interest.symbols.insert(*id);
+                    }
+                }
+                else {
+                    interest.all_symbols = true;
+                }
+            }
+        }
+
+        currencies.clear();
+        interests.clear();
+        for (auto& [currency, interest] : active) {
+            fx_rates.prefetch(currency);
+            currencies.push_back(currency);
+            interests.push_back(std::move(interest));
+        }
+        batches.resize(currencies.size());
+        spdlog::info("Quote feed publishing {} currencies", currencies.size());
+    }
+
+    // Binary consumers learn an id's symbol before its first binary quote.
+    // An entry the socket refused is tried again on the symbol's next
+    // binary quote. False if the id does not fit the wire format, in which
+    // case the symbol has no binary quotes.
+    bool QuoteFeed::announce(SymbolId id, const std::string& symbol) {
+        if (id > QuoteWire::LocalIdMask) {
+            return false;
+        }
+        if (id >= announced.size()) {
+            announced.resize(id + 1, Announced::No);
+        }
+        if (announced[id] == Announced::Sent) {
+            return true;
+        }
+
+        if (announced[id] == Announced::No) {
+            announced_ids.push_back(id);
+        }
+        announced[id] = sendDictionaryEntry(id, symbol) ? Announced::Sent : Announced::Retry;
+        return true;
+    }
+
+    bool QuoteFeed::sendDictionaryEntry(SymbolId id, const std::string& symbol) {
+        zmq::message_t entry(sizeof(uint32_t) + symbol.size());
+        auto* bytes = static_cast<unsigned char*>(entry.data());
+        QuoteWire::detail::putLE<uint32_t>(bytes, QuoteWire::wireSymbolId(member, id));
+        std::memcpy(bytes + sizeof(uint32_t), symbol.data(), symbol.size());
+
+        // Both frames go or neither does: the high water mark is checked
+        // per message, before its first frame
+        if (!socket.send(zmq::buffer(QuoteWire::DictionaryTopic), zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+            return false;
+        }
+        socket.send(entry, zmq::send_flags::dontwait);
+        return true;
+    }
+
+    void QuoteFeed::beginCycle() {
+        if (readSubscriptions()) {
+            rebuildCurrencies();
+        }
+
+        if (resend_dictionary) {
+            for (SymbolId id : announced_ids) {
+                announced[id] = sendDictionaryEntry(id, symbol_table.name(id)) ? Announced::Sent : Announced::Retry;
+            }
+            resend_dictionary = false;
+        }
+
+        // One cache lookup per currency per cycle; publish() only multiplies
+        rates.resize(currencies.size());
+        for (size_t i = 0; i < currencies.size(); ++i) {
+            rates[i] = fx_rates.rate(currencies[i]).value_or(std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+
+    void QuoteFeed::publish(const Tick& tick) {
+        const size_t count = currencies.size();
+        if (count == 0) {
+            return;
+        }
+
+        // Convert for all active currencies in one pass
+        prices.resize(count);
+        const double usd_price = tick.price;
+        for (size_t i = 0; i < count; ++i) {
+            prices[i] = usd_price * rates[i];
+        }
+
+        // Name is only needed for topics and text payloads
+        const std::string& symbol = symbol_table.name(tick.symbol);
+
+        for (size_t i = 0; i < count; ++i) {
+            if (std::isnan(prices[i])) {
+                continue;  // No rate yet
+            }
+            if (interests[i].text.wants(tick.symbol)) {
+                sendText(tick, symbol, currencies[i], prices[i]);
+            }
+            if (interests[i].binary.wants(tick.symbol)) {
+                sendBinary(tick, symbol, currencies[i], prices[i]);
+            }
+            if (interests[i].text_batch || interests[i].binary_batch) {
+                appendToBatch(i, tick, symbol, prices[i]);
+            }
+        }
+    }
+
+    void QuoteFeed::appendToBatch(size_t index, const Tick& tick, const std::string& symbol, double price) {
+        auto& batch = batches[index];
+        const auto& currency = currencies[index];
+
+        if (interests[index].text_batch) {
+            if (batch.text.size() != 0) {
+                batch.text.push_back('\n');
+            }
+            QuoteWire::encodeText(batch.text, symbol, price, tick.change_percent, tick.timestamp, currency);
+        }
+
+        if (interests[index].binary_batch && announce(tick.symbol, symbol)) {
+            size_t offset = batch.binary.size();
+            batch.binary.resize(offset + QuoteWire::BinaryQuoteSize);
+            QuoteWire::encodeBinary(batch.binary.data() + offset, QuoteWire::wireSymbolId(member, tick.symbol),
+                currency, price, tick.change_percent, tick.timestamp);
+        }
+
+        if (!batch_started) {
+            batch_started = std::chrono::steady_clock::now();
+        }
+    }
+
+    void QuoteFeed::flushBatches() {
+        for (size_t i = 0; i < batches.size(); ++i) {
+            auto& batch = batches[i];
+            for (auto format : { QuoteWire::Format::Text, QuoteWire::Format::Binary }) {
+                auto& body = format == QuoteWire::Format::Binary ? batch.binary : batch.text;
+                if (body.size() == 0) {
+                    continue;
+                }
+
+                topic.clear();
+                QuoteWire::batchTopic(topic, format, currencies[i]);
+                socket.send(zmq::buffer(topic.data(), topic.size()), zmq::send_flags::sndmore | zmq::send_flags::dontwait);
+                socket.send(zmq::buffer(body.data(), body.size()), zmq::send_flags::dontwait);
+                body.clear();
+                ++batches_sent;
+            }
+        }
+        batch_started.reset();
+    }
+
+    void QuoteFeed::endCycle() {
+        if (!batch_started) {
+            return;
+        }
+        if (std::chrono::steady_clock::now() - *batch_started >= config.batch_window) {
+            flushBatches();
+        }
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> QuoteFeed::flushDeadline() const {
+        if (!batch_started) {
+            return std::nullopt;
+        }
+        return *batch_started + config.batch_window;
+    }
+
+    void QuoteFeed::sendText(const Tick& tick, const std::string& symbol, const std::string& currency, double price) {
+        topic.clear();
+        QuoteWire::quoteTopic(topic, QuoteWire::Format::Text, currency, symbol);
+        payload.clear();
+        QuoteWire::encodeText(payload, symbol, price, tick.change_percent, tick.timestamp, currency);
+
+        socket.send(zmq::buffer(topic.data(), topic.size()), zmq::send_flags::sndmore | zmq::send_flags::dontwait);
+        socket.send(zmq::buffer(payload.data(), payload.size()), zmq::send_flags::dontwait);
+        ++published;
+    }
+
+    void QuoteFeed::sendBinary(const Tick& tick, const std::string& symbol, const std::string& currency, double price) {
+        if (!announce(tick.symbol, symbol)) {
+            return;
+        }
+
+        topic.clear();
+        QuoteWire::quoteTopic(topic, QuoteWire::Format::Binary, currency, symbol);
+
+        // Encoded straight into the message body; 32 bytes fit in ZeroMQ's
+        // inline small-message storage, so there is no heap allocation
+        zmq::message_t body(QuoteWire::BinaryQuoteSize);
+        QuoteWire::encodeBinary(body.data(), QuoteWire::wireSymbolId(member, tick.symbol), currency, price,
+            tick.change_percent, tick.timestamp);
+
+        socket.send(zmq::buffer(topic.data(), topic.size()), zmq::send_flags::sndmore | zmq::send_flags::dontwait);
+        socket.send(body, zmq::send_flags::dontwait);
+        ++published;
+    }
+}
@@ -0,0 +1,308 @@
+// StockTracker.DataService/src/RemoteDataProvider.cpp
+#include "RemoteDataProvider.h"
+#include <spdlog/spdlog.h>
+#include <future>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    namespace {
+        const char* const WakeEndpoint = "inproc://remote-provider-wake";
+    }
+
+    RemoteDataProvider::RemoteDataProvider(SymbolTable& symbol_table, const RemoteProviderConfig& config)
+        : symbol_table(symbol_table)
+        , config(config)
+        , context(1)
+        , dealer(context, zmq::socket_type::dealer)
+        , wake_pull(context, zmq::socket_type::pull)
+        , wake_push(context, zmq::socket_type::push)
+        , stream_sub(context, zmq::socket_type::sub)
+    {
+        dealer.set(zmq::sockopt::linger, 0);
+        dealer.connect(config.endpoint);
+        wake_pull.bind(WakeEndpoint);
+        wake_push.connect(WakeEndpoint);
+
+        if (!config.stream_endpoint.empty()) {
+            stream_sub.connect(config.stream_endpoint);
+            stream_sub.set(zmq::sockopt::subscribe, "");
+        }
+
+        io_thread = std::thread(&RemoteDataProvider::ioLoop, this);
+
+        if (config.symbols.empty()) {
+            loadSymbols();
+        }
+        else {
+            for (const auto& symbol : config.symbols) {
+                addSymbol(symbol);
+            }
+        }
+        spdlog::info("Remote data provider on {} with {} symbols", config.endpoint, available.size());
+    }
+
+    RemoteDataProvider::~RemoteDataProvider() {
+        running = false;
+        {
+            std::lock_guard lock(submit_mutex);
+            wake_push.send(zmq::message_t(), zmq::send_flags::dontwait);
+        }
+        if (io_thread.joinable()) {
+            io_thread.join();
+        }
+    }
+
+    void RemoteDataProvider::addSymbol(const std::string& symbol) {
+        SymbolId id = symbol_table.intern(symbol);
+        if (id >= known.size()) {
+            known.resize(id + 1, 0);
+        }
+        if (!known[id]) {
+            known[id] = 1;
+            available.push_back(id);
+        }
+    }
+
+    void RemoteDataProvider::loadSymbols() {
+        std::promise<std::vector<std::string>> reply;
+        auto symbols = reply.get_future();
+        submit("SYMBOLS", "", [&reply](const std::string* body) {
+            std::vector<std::string> names;
+            if (body) {
+                std::istringstream in(*body);
+                std::string name;
+                while (in >> name) {
+                    names.push_back(name);
+                }
+            }
+            reply.set_value(std::move(names));
+        });
+
+        auto names = symbols.get();
+        if (names.empty()) {
+            throw std::runtime_error("No symbols available from market data gateway at " + config.endpoint);
+        }
+        for (const auto& name : names) {
+            addSymbol(name);
+        }
+    }
+
+    void RemoteDataProvider::submit(const std::string& verb, const std::string& args, ReplyHandler done) {
+        Request request;
+        request.id = next_id++;
+        request.payload = verb + " " + std::to_string(request.id) + args;
+        request.done = std::move(done);
+        request.deadline = std::chrono::steady_clock::now() + config.request_timeout;
+
+        std::lock_guard lock(submit_mutex);
+        submitted.push_back(std::move(request));
+        wake_push.send(zmq::message_t(), zmq::send_flags::dontwait);
+    }
+
+    void RemoteDataProvider::requestTicks(std::vector<SymbolId> ids, TickHandler done) {
+        std::string args;
+        for (SymbolId id : ids) {
+            if (isValidSymbol(id)) {
+                args += ' ';
+                args += symbol_table.name(id);
+            }
+        }
+
+        if (args.empty()) {
+            done({});
+            return;
+        }
+
+        submit("TICKS", args, [this, done = std::move(done)](const std::string* body) {
+            done(body ? parseTicks(*body) : std::vector<Tick>{});
+        });
+    }
+
+    void RemoteDataProvider::generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) {
+        std::promise<std::vector<Tick>> reply;
+        auto ticks = reply.get_future();
+        requestTicks(std::vector<SymbolId>(ids, ids + count), [&reply](std::vector<Tick> result) {
+            reply.set_value(std::move(result));
+        });
+
+        auto result = ticks.get();
+        out.insert(out.end(), result.begin(), result.end());
+    }
+
+    bool RemoteDataProvider::startStreaming(TickStream& target) {
+        if (config.stream_endpoint.empty()) {
+            return false;
+        }
+        stream = &target;
+        spdlog::info("Streaming ticks from {}", config.stream_endpoint);
+        return true;
+    }
+
+    StockQuote RemoteDataProvider::generateQuote(const std::string& symbol) {
+        auto id = symbol_table.find(symbol);
+        if (!id || !isValidSymbol(*id)) {
+            throw std::runtime_error("Invalid symbol: " + symbol);
+        }
+
+        std::vector<Tick> ticks;
+        generateTicks(&*id, 1, ticks);
+        if (ticks.empty()) {
+            throw std::runtime_error("No quote available for " + symbol);
+        }
+
+        StockQuote quote{ symbol, ticks.front().price, ticks.front().timestamp };
+        quote.change_percent = ticks.front().change_percent;
+        return quote;
+    }
+
+    bool RemoteDataProvider::isValidSymbol(const std::string& symbol) const {
+        auto id = symbol_table.find(symbol);
+        return id && isValidSymbol(*id);
+    }
+
+    bool RemoteDataProvider::isValidSymbol(SymbolId id) const {
+        return id < known.size() && known[id] != 0;
+    }
+
+    std::vector<std::string> RemoteDataProvider::getAvailableSymbols() const {
+        std::vector<std::string> symbols;
+        symbols.reserve(available.size());
+        for (SymbolId id : available) {
+            symbols.push_back(symbol_table.name(id));
+        }
+        return symbols;
+    }
+
+    std::vector<Tick> RemoteDataProvider::parseTicks(const std::string& body) const {
+        std::vector<Tick> ticks;
+        std::istringstream in(body);
+        std::string symbol;
+        double price = 0.0;
+        double change_percent = 0.0;
+        int64_t timestamp_ms = 0;
+
+        while (in >> symbol >> price >> change_percent >> timestamp_ms) {
+            auto id = symbol_table.find(symbol);
+            if (!id || !isValidSymbol(*id)) {
+                continue;
+            }
+            ticks.push_back(Tick{ *id, price, change_percent,
+                std::chrono::system_clock::time_point(std::chrono::milliseconds(timestamp_ms)) });
+        }
+        return ticks;
+    }
+
+    void RemoteDataProvider::ioLoop() {
+        zmq::pollitem_t items[] = {
+            { dealer.handle(), 0, ZMQ_POLLIN, 0 },
+            { wake_pull.handle(), 0, ZMQ_POLLIN, 0 },
+            { stream_sub.handle(), 0, ZMQ_POLLIN, 0 },
+        };
+        const int item_count = config.stream_endpoint.empty() ? 2 : 3;
+
+        while (running) {
+            try {
+                zmq::poll(items, item_count, std::chrono::milliseconds(100));
+
+                if (item_count == 3 && (items[2].revents & ZMQ_POLLIN)) {
+                    receiveStream();
+                }
+
+                if (items[1].revents & ZMQ_POLLIN) {
+                    zmq::message_t wake;
+                    while (wake_pull.recv(wake, zmq::recv_flags::dontwait)) {
+                    }
+                }
+                sendSubmitted();
+
+                if (items[0].revents & ZMQ_POLLIN) {
+                    zmq::message_t reply;
+                    while (dealer.recv(reply, zmq::recv_flags::dontwait)) {
+                        handleReply(reply.to_string());
+                    }
+                }
+
+                expire(std::chrono::steady_clock::now());
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Remote data provider error: {}", e.what());
+            }
+        }
+
+        // Fail whatever is still outstanding so no caller waits forever
+        sendSubmitted();
+        expire(std::chrono::steady_clock::time_point::max());
+    }
+
+    void RemoteDataProvider::receiveStream() {
+        TickStream* target = stream.load();
+        zmq::message_t frame;
+        while (stream_sub.recv(frame, zmq::recv_flags::dontwait)) {
+            if (!target) {
+                continue;  // Not streaming yet
+            }
+            for (const auto& tick : parseTicks(frame.to_string())) {
+                target->push(tick);
+            }
+        }
+    }
+
+    void RemoteDataProvider::sendSubmitted() {
+        std::deque<Request> batch;
+        {
+            std::lock_guard lock(submit_mutex);
+            batch.swap(submitted);
+        }
+
+        for (auto& request : batch) {
+            if (running) {
+                dealer.send(zmq::buffer(request.payload), zmq::send_flags::dontwait);
+            }
+            in_flight.emplace(request.id, std::move(request));
+        }
+    }
+
+    void RemoteDataProvider::handleReply(const std::string& reply) {
+        std::istringstream in(reply);
+        std::string verb;
+        uint64_t id = 0;
+        in >> verb >> id;
+
+        auto it = in_flight.find(id);
+        if (it == in_flight.end()) {
+            return;  // Already timed out
+        }
+        auto request = std::move(it->second);
+        in_flight.erase(it);
+
+        if (verb == "ERROR") {
+            std::string reason;
+            std::getline(in, reason);
+            spdlog::warn("Market data gateway rejected request {}:{}", id, reason);
+            request.done(nullptr);
+            return;
+        }
+
+        std::string body(std::istreambuf_iterator<char>(in), {});
+        request.done(&body);
+    }
+
+    void RemoteDataProvider::expire(std::chrono::steady_clock::time_point now) {
+        for (auto it = in_flight.begin(); it != in_flight.end();) {
+            if (it->second.deadline <= now) {
+                if (now != std::chrono::steady_clock::time_point::max()) {
+                    spdlog::warn("Market data request {} timed out", it->first);
+                }
+                auto done = std::move(it->second.done);
+                it = in_flight.erase(it);
+                done(nullptr);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+}
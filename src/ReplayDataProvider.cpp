@@ -0,0 +1,190 @@
+// StockTracker.DataService/src/ReplayDataProvider.cpp
+#include "ReplayDataProvider.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    ReplayDataProvider::ReplayDataProvider(SymbolTable& symbol_table, const ReplayProviderConfig& config)
+        : symbol_table(symbol_table)
+        , config(config)
+    {
+        scanSymbols();
+    }
+
+    ReplayDataProvider::~ReplayDataProvider() {
+        {
+            std::lock_guard lock(stop_mutex);
+            running = false;
+        }
+        stop_signal.notify_all();
+        if (feed_thread.joinable()) {
+            feed_thread.join();
+        }
+    }
+
+    bool ReplayDataProvider::parseLine(const std::string& line, std::string& symbol, Tick& tick) {
+        std::istringstream in(line);
+        int64_t timestamp_ms = 0;
+        if (!(in >> symbol >> tick.price >> tick.change_percent >> timestamp_ms)) {
+            return false;
+        }
+        tick.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(timestamp_ms));
+        return true;
+    }
+
+    void ReplayDataProvider::scanSymbols() {
+        std::ifstream in(config.path);
+        if (!in) {
+            throw std::runtime_error("Cannot open replay file: " + config.path);
+        }
+
+        std::string line;
+        std::string symbol;
+        Tick tick{};
+        size_t records = 0;
+        while (std::getline(in, line)) {
+            if (!parseLine(line, symbol, tick)) {
+                continue;
+            }
+            ++records;
+            SymbolId id = symbol_table.intern(symbol);
+            if (id >= known.size()) {
+                known.resize(id + 1, 0);
+            }
+            if (!known[id]) {
+                known[id] = 1;
+                available.push_back(id);
+            }
+        }
+
+        last.resize(known.size(), Tick{});
+        spdlog::info("Replay file {}: {} ticks for {} symbols", config.path, records, available.size());
+    }
+
+    bool ReplayDataProvider::startStreaming(TickStream& stream) {
+        feed_thread = std::thread(&ReplayDataProvider::replayLoop, this, std::ref(stream));
+        return true;
+    }
+
+    bool ReplayDataProvider::sleepUntil(std::chrono::steady_clock::time_point when) {
+        std::unique_lock lock(stop_mutex);
+        return !stop_signal.wait_until(lock, when, [this] { return !running.load(); });
+    }
+
+    void ReplayDataProvider::replayLoop(TickStream& stream) {
+        do {
+            std::ifstream in(config.path);
+            if (!in) {
+                spdlog::error("Cannot reopen replay file {}", config.path);
+                return;
+            }
+            if (!replayFile(in, stream)) {
+                return;
+            }
+        } while (config.loop && running);
+
+        spdlog::info("Replay finished: {} ticks", replayed.load());
+    }
+
+    bool ReplayDataProvider::replayFile(std::ifstream& in, TickStream& stream) {
+        using Clock = std::chrono::steady_clock;
+
+        std::string line;
+        std::string symbol;
+        Tick tick{};
+        std::optional<std::chrono::system_clock::time_point> first_recorded;
+        const auto started = Clock::now();
+
+        while (running && std::getline(in, line)) {
+            if (!parseLine(line, symbol, tick)) {
+                continue;
+            }
+            auto id = symbol_table.find(symbol);
+            if (!id || !isValidSymbol(*id)) {
+                continue;
+            }
+            tick.symbol = *id;
+
+            // Hold each tick until its recorded offset, scaled by speed
+            if (config.speed > 0.0) {
+                if (!first_recorded) {
+                    first_recorded = tick.timestamp;
+                }
+                auto offset = std::chrono::duration<double>(tick.timestamp - *first_recorded) / config.speed;
+                auto due = started + std::chrono::duration_cast<Clock::duration>(offset);
+                if (due > Clock::now() && !sleepUntil(due)) {
+                    return false;
+                }
+            }
+
+            if (config.rebase_timestamps) {
+                tick.timestamp = std::chrono::system_clock::now();
+            }
+
+            {
+                std::lock_guard lock(last_mutex);
+                last[tick.symbol] = tick;
+            }
+
+            // Wait for room rather than drop: a replay should deliver every
+            // recorded tick, at whatever rate the service sustains
+            while (!stream.tryPush(tick)) {
+                if (!running || stream.isClosed()) {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+            replayed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return running.load();
+    }
+
+    StockQuote ReplayDataProvider::generateQuote(const std::string& symbol) {
+        auto id = symbol_table.find(symbol);
+        if (!id || !isValidSymbol(*id)) {
+            throw std::runtime_error("Invalid symbol: " + symbol);
+        }
+
+        std::vector<Tick> ticks;
+        generateTicks(&*id, 1, ticks);
+        if (ticks.empty()) {
+            throw std::runtime_error("No replayed quote yet for " + symbol);
+        }
+
+        StockQuote quote{ symbol, ticks.front().price, ticks.front().timestamp };
+        quote.change_percent = ticks.front().change_percent;
+        return quote;
+    }
+
+    bool ReplayDataProvider::isValidSymbol(const std::string& symbol) const {
+        auto id = symbol_table.find(symbol);
+        return id && isValidSymbol(*id);
+    }
+
+    bool ReplayDataProvider::isValidSymbol(SymbolId id) const {
+        return id < known.size() && known[id] != 0;
+    }
+
+    std::vector<std::string> ReplayDataProvider::getAvailableSymbols() const {
+        std::vector<std::string> symbols;
+        symbols.reserve(available.size());
+        for (SymbolId id : available) {
+            symbols.push_back(symbol_table.name(id));
+        }
+        return symbols;
+    }
+
+    void ReplayDataProvider::generateTicks(const SymbolId* ids, size_t count, std::vector<Tick>& out) {
+        std::lock_guard lock(last_mutex);
+        for (size_t i = 0; i < count; ++i) {
+            if (isValidSymbol(ids[i]) && last[ids[i]].price != 0.0) {
+                out.push_back(last[ids[i]]);
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+// StockTracker.DataService/src/RequestServer.cpp
+#include "RequestServer.h"
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace StockTracker {
+
+    RequestServer::RequestServer(const RequestServerConfig& config, Handler handler)
+        : config(config)
+        , handler(std::move(handler))
+        , context(1)
+        , socket(context, zmq::socket_type::router)
+    {
+        socket.set(zmq::sockopt::linger, 0);
+        socket.bind(config.endpoint);
+        spdlog::info("Request server bound to {}", config.endpoint);
+
+        server_thread = std::thread(&RequestServer::serve, this);
+    }
+
+    RequestServer::~RequestServer() {
+        stop();
+    }
+
+    void RequestServer::stop() {
+        running = false;
+        if (server_thread.joinable()) {
+            server_thread.join();
+        }
+    }
+
+    void RequestServer::serve() {
+        // Poll with a timeout so stop() is noticed promptly
+        zmq::pollitem_t items[] = { { socket.handle(), 0, ZMQ_POLLIN, 0 } };
+
+        while (running) {
+            try {
+                zmq::poll(items, 1, std::chrono::milliseconds(100));
+                if (items[0].revents & ZMQ_POLLIN) {
+                    handleOne();
+                }
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Request server error: {}", e.what());
+            }
+        }
+    }
+
+    // ROUTER frames: [routing id][empty delimiter (REQ only)][request]. The
+    // envelope is sent back unchanged in front of the reply.
+    void RequestServer::handleOne() {
+        std::vector<zmq::message_t> envelope;
+        zmq::message_t frame;
+        while (true) {
+            if (!socket.recv(frame, zmq::recv_flags::dontwait)) {
+                return;
+            }
+            if (!frame.more()) {
+                break;
+            }
+            envelope.push_back(std::move(frame));
+            frame = zmq::message_t();
+        }
+
+        std::string reply;
+        try {
+            reply = handler(frame.to_string());
+        }
+        catch (const std::exception& e) {
+            reply = std::string("ERROR ") + e.what();
+        }
+
+        for (auto& part : envelope) {
+            socket.send(part, zmq::send_flags::sndmore);
+        }
+        socket.send(zmq::buffer(reply), zmq::send_flags::none);
+    }
+}
@@ -0,0 +1,181 @@
+// StockTracker.DataService/src/RetentionManager.cpp
+#include "RetentionManager.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    namespace {
+        int64_t sinceEpoch(std::chrono::system_clock::time_point time, std::chrono::nanoseconds unit) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count() / unit.count();
+        }
+    }
+
+    RetentionManager::RetentionManager(const std::string& path, const DatabaseTuningConfig& tuning,
+        DatabaseMutex& database_mutex, const RetentionConfig& config)
+        : config(config)
+        , database_mutex(database_mutex)
+        , connection(path, tuning)
+    {
+        sqlite3_stmt* mode = connection.statement("PRAGMA auto_vacuum");
+        incremental_vacuum = sqlite3_step(mode) == SQLITE_ROW && sqlite3_column_int(mode, 0) == 2;
+        sqlite3_reset(mode);
+
+        if (!incremental_vacuum && config.convert_auto_vacuum) {
+            spdlog::info("Converting database to incremental auto_vacuum (full VACUUM)");
+            std::lock_guard db_lock(database_mutex);
+            connection.exec("PRAGMA auto_vacuum=INCREMENTAL");
+            connection.exec("VACUUM");
+            incremental_vacuum = true;
+        }
+        else if (!incremental_vacuum) {
+            spdlog::info("Database is not in incremental auto_vacuum mode; space freed by retention is reused but not returned");
+        }
+
+        sweeper_thread = std::thread(&RetentionManager::sweepLoop, this);
+    }
+
+    RetentionManager::~RetentionManager() {
+        stop();
+    }
+
+    void RetentionManager::stop() {
+        {
+            std::lock_guard lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        if (sweeper_thread.joinable()) {
+            sweeper_thread.join();
+        }
+    }
+
+    RetentionStats RetentionManager::stats() const {
+        RetentionStats s;
+        s.sweeps = sweeps.load();
+        s.ticks_deleted = ticks_deleted.load();
+        s.bars_deleted = bars_deleted.load();
+        s.pages_vacuumed = pages_vacuumed.load();
+        return s;
+    }
+
+    void RetentionManager::sweepLoop() {
+        // First sweep shortly after startup, then on the interval
+        auto next_sweep = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        std::unique_lock lock(wake_mutex);
+        while (!stopping) {
+            wake.wait_until(lock, next_sweep, [this] { return stopping; });
+            if (stopping) {
+                break;
+            }
+            lock.unlock();
+
+            try {
+                sweep();
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Retention sweep failed: {}", e.what());
+            }
+
+            next_sweep = std::chrono::steady_clock::now() + config.sweep_interval;
+            lock.lock();
+        }
+    }
+
+    bool RetentionManager::pause() {
+        std::unique_lock lock(wake_mutex);
+        return !wake.wait_for(lock, config.batch_pause, [this] { return stopping; });
+    }
+
+    void RetentionManager::sweep() {
+        const auto now = std::chrono::system_clock::now();
+        uint64_t ticks = 0;
+        uint64_t bars = 0;
+
+        // No price_ticks table when ticks go to the tick journal
+        if (config.raw_retention.count() > 0 && connection.hasTable("price_ticks")) {
+            ticks = deleteTicks(now - config.raw_retention);
+        }
+        if (config.bar_retention.count() > 0) {
+            bars = deleteBars(now - config.bar_retention);
+        }
+
+        if (incremental_vacuum && ticks + bars > 0) {
+            vacuum();
+        }
+
+        ++sweeps;
+        if (ticks + bars > 0) {
+            spdlog::info("Retention sweep removed {} ticks and {} bars", ticks, bars);
+        }
+    }
+
+    uint64_t RetentionManager::deleteTicks(std::chrono::system_clock::time_point cutoff) {
+        const auto cutoff_ms = sinceEpoch(cutoff, std::chrono::milliseconds(1));
+
+        // Rows are appended in time order, so the expired ones sit at the
+        // low rowids. Each batch looks only at the oldest few rows and the
+        // sweep ends once a batch reaches rows inside the window.
+        uint64_t deleted = 0;
+        while (true) {
+            std::unique_lock db_lock(database_mutex);
+            sqlite3_stmt* stmt = connection.statement("DELETE FROM price_ticks WHERE rowid IN "
+                "(SELECT rowid FROM price_ticks ORDER BY rowid LIMIT ?) AND timestamp_ms < ?");
+            sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(config.delete_batch_size));
+            sqlite3_bind_int64(stmt, 2, cutoff_ms);
+
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                connection.fail("Failed to delete expired ticks");
+            }
+            auto changes = static_cast<size_t>(sqlite3_changes(connection.handle()));
+            db_lock.unlock();
+            deleted += changes;
+            ticks_deleted += changes;
+
+            if (changes < config.delete_batch_size || !pause()) {
+                break;
+            }
+        }
+        return deleted;
+    }
+
+    uint64_t RetentionManager::deleteBars(std::chrono::system_clock::time_point cutoff) {
+        const auto cutoff_ms = sinceEpoch(cutoff, std::chrono::milliseconds(1));
+
+        uint64_t deleted = 0;
+        while (true) {
+            std::unique_lock db_lock(database_mutex);
+            sqlite3_stmt* stmt = connection.statement("DELETE FROM price_bars WHERE rowid IN "
+                "(SELECT rowid FROM price_bars WHERE start_ms < ? LIMIT ?)");
+            sqlite3_bind_int64(stmt, 1, cutoff_ms);
+            sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(config.delete_batch_size));
+
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                connection.fail("Failed to delete expired bars");
+            }
+            auto changes = static_cast<size_t>(sqlite3_changes(connection.handle()));
+            db_lock.unlock();
+            deleted += changes;
+            bars_deleted += changes;
+
+            if (changes < config.delete_batch_size || !pause()) {
+                break;
+            }
+        }
+        return deleted;
+    }
+
+    void RetentionManager::vacuum() {
+        sqlite3_stmt* before = connection.statement("PRAGMA freelist_count");
+        int64_t free_pages = sqlite3_step(before) == SQLITE_ROW ? sqlite3_column_int64(before, 0) : 0;
+        sqlite3_reset(before);
+
+        {
+            std::lock_guard db_lock(database_mutex);
+            connection.exec("PRAGMA incremental_vacuum(" + std::to_string(config.vacuum_pages) + ")");
+        }
+        pages_vacuumed += static_cast<uint64_t>(std::min<int64_t>(free_pages, static_cast<int64_t>(config.vacuum_pages)));
+    }
+}
@@ -0,0 +1,155 @@
+// StockTracker.DataService/src/RollupEngine.cpp
+#include "RollupEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace StockTracker {
+
+    RollupEngine::RollupEngine(const RollupConfig& config, Sink sink)
+        : config(config)
+        , sink(std::move(sink))
+        , series(config.resolutions.size())
+    {
+    }
+
+    std::optional<size_t> RollupEngine::indexOf(BarResolution resolution) const {
+        for (size_t i = 0; i < config.resolutions.size(); ++i) {
+            if (config.resolutions[i] == resolution) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void RollupEngine::update(const std::vector<Tick>& ticks) {
+        if (ticks.empty()) {
+            return;
+        }
+
+        std::lock_guard lock(mutex);
+        for (size_t i = 0; i < config.resolutions.size(); ++i) {
+            if (config.resolutions[i] == BarResolution::Raw) {
+                continue;
+            }
+            for (const auto& tick : ticks) {
+                add(i, tick);
+            }
+        }
+    }
+
+    void RollupEngine::add(size_t index, const Tick& tick) {
+        auto& s = series[index];
+        if (tick.symbol >= s.current.size()) {
+            s.current.resize(tick.symbol + 1);
+            s.closed.resize(tick.symbol + 1);
+        }
+
+        const auto width = barWidth(config.resolutions[index]);
+        const auto since_epoch = tick.timestamp.time_since_epoch();
+        const auto start = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(since_epoch - since_epoch % width));
+
+        auto& acc = s.current[tick.symbol];
+        if (acc.open && start != acc.ohlc.start) {
+            close(index, tick.symbol);
+        }
+
+        if (!acc.open) {
+            acc = Accumulator{};
+            acc.open = true;
+            acc.ohlc = PriceBar{ start, tick.price, tick.price, tick.price, tick.price, 1 };
+            acc.mean = tick.price;
+            next_expiry = std::min(next_expiry, start + width);
+            return;
+        }
+
+        const double previous = acc.ohlc.close;
+        auto& bar = acc.ohlc;
+        bar.high = std::max(bar.high, tick.price);
+        bar.low = std::min(bar.low, tick.price);
+        bar.close = tick.price;
+        ++bar.count;
+
+        acc.mean += (tick.price - acc.mean) / bar.count;
+
+        if (previous != 0.0) {
+            double ret = tick.price / previous - 1.0;
+            ++acc.returns;
+            double ret_delta = ret - acc.return_mean;
+            acc.return_mean += ret_delta / acc.returns;
+            acc.return_m2 += ret_delta * (ret - acc.return_mean);
+        }
+    }
+
+    RollupBar RollupEngine::finish(const Accumulator& acc, SymbolId symbol, BarResolution resolution) {
+        double volatility = acc.returns > 1 ? std::sqrt(acc.return_m2 / (acc.returns - 1)) : 0.0;
+        return RollupBar{ symbol, resolution, acc.ohlc, acc.mean, volatility };
+    }
+
+    void RollupEngine::close(size_t index, SymbolId symbol) {
+        auto& s = series[index];
+        auto& acc = s.current[symbol];
+        auto bar = finish(acc, symbol, config.resolutions[index]);
+        acc.open = false;
+
+        auto& closed = s.closed[symbol];
+        closed.push_back(bar);
+        while (closed.size() > config.retained_bars) {
+            closed.pop_front();
+        }
+
+        if (sink) {
+            sink(bar);
+        }
+    }
+
+    void RollupEngine::closeExpired(std::chrono::system_clock::time_point now) {
+        std::lock_guard lock(mutex);
+        if (now < next_expiry) {
+            return;
+        }
+
+        next_expiry = std::chrono::system_clock::time_point::max();
+        for (size_t i = 0; i < series.size(); ++i) {
+            const auto width = barWidth(config.resolutions[i]);
+            auto& current = series[i].current;
+            for (SymbolId id = 0; id < current.size(); ++id) {
+                if (!current[id].open) {
+                    continue;
+                }
+                auto end = current[id].ohlc.start + width;
+                if (end <= now) {
+                    close(i, id);
+                }
+                else {
+                    next_expiry = std::min(next_expiry, end);
+                }
+            }
+        }
+    }
+
+    std::vector<RollupBar> RollupEngine::recent(SymbolId symbol, BarResolution resolution, size_t limit,
+        bool include_open) const {
+        std::vector<RollupBar> bars;
+        auto index = indexOf(resolution);
+        if (!index) {
+            return bars;
+        }
+
+        std::lock_guard lock(mutex);
+        const auto& s = series[*index];
+        if (symbol >= s.current.size()) {
+            return bars;
+        }
+
+        const bool with_open = include_open && s.current[symbol].open && limit > 0;
+        const auto& closed = s.closed[symbol];
+        size_t count = std::min(limit - (with_open ? 1 : 0), closed.size());
+        bars.assign(closed.end() - count, closed.end());
+
+        if (with_open) {
+            bars.push_back(finish(s.current[symbol], symbol, resolution));
+        }
+        return bars;
+    }
+}
@@ -0,0 +1,102 @@
+// StockTracker.DataService/src/ShardPool.cpp
+#include "ShardPool.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace StockTracker {
+
+    size_t ShardPool::resolveCount(const ShardPoolConfig& config) {
+        if (config.shards != 0) {
+            return config.shards;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    ShardPool::ShardPool(const ShardPoolConfig& config, Job job)
+        : job(std::move(job))
+        , workers(resolveCount(config))
+    {
+        for (size_t shard = 1; shard < workers.size(); ++shard) {
+            workers[shard].thread = std::thread(&ShardPool::workerLoop, this, shard);
+        }
+        spdlog::info("Generating ticks on {} shards", workers.size());
+    }
+
+    ShardPool::~ShardPool() {
+        stop();
+    }
+
+    void ShardPool::run(const std::vector<SymbolId>& ids) {
+        for (auto& worker : workers) {
+            worker.ids.clear();
+        }
+        for (SymbolId id : ids) {
+            workers[id % workers.size()].ids.push_back(id);
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            for (size_t shard = 1; shard < workers.size(); ++shard) {
+                if (!workers[shard].ids.empty()) {
+                    workers[shard].has_work = true;
+                    ++outstanding;
+                }
+            }
+        }
+        work_ready.notify_all();
+
+        // Caught like the workers' jobs: returning early would let the next
+        // cycle refill ids and outputs the workers are still using
+        if (!workers[0].ids.empty()) {
+            try {
+                job(0, workers[0].ids);
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Shard 0 failed: {}", e.what());
+            }
+        }
+
+        std::unique_lock lock(mutex);
+        work_done.wait(lock, [this] { return outstanding == 0; });
+    }
+
+    void ShardPool::workerLoop(size_t shard) {
+        auto& worker = workers[shard];
+
+        std::unique_lock lock(mutex);
+        while (true) {
+            work_ready.wait(lock, [&] { return stopping || worker.has_work; });
+            if (stopping) {
+                break;
+            }
+            lock.unlock();
+
+            try {
+                job(shard, worker.ids);
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Shard {} failed: {}", shard, e.what());
+            }
+
+            lock.lock();
+            worker.has_work = false;
+            if (--outstanding == 0) {
+                work_done.notify_one();
+            }
+        }
+    }
+
+    void ShardPool::stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+
+        for (auto& worker : workers) {
+            if (worker.thread.joinable()) {
+                worker.thread.join();
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// StockTracker.DataService/src/SqliteConnection.cpp
+#include "SqliteConnection.h"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    SqliteConnection::SqliteConnection(const std::string& path, const DatabaseTuningConfig& tuning) {
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+            std::string error = db ? sqlite3_errmsg(db) : "out of memory";
+            sqlite3_close(db);
+            throw std::runtime_error("Failed to open " + path + ": " + error);
+        }
+
+        try {
+            applyTuning(tuning);
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    SqliteConnection::~SqliteConnection() {
+        close();
+    }
+
+    void SqliteConnection::close() {
+        for (auto& [sql, stmt] : statements) {
+            sqlite3_finalize(stmt);
+        }
+        statements.clear();
+        sqlite3_close(db);
+        db = nullptr;
+    }
+
+    void SqliteConnection::applyTuning(const DatabaseTuningConfig& tuning) {
+        // DatabaseService writes the same file through its own connection
+        sqlite3_busy_timeout(db, static_cast<int>(tuning.busy_timeout.count()));
+
+        if (!tuning.journal_mode.empty()) {
+            exec("PRAGMA journal_mode=" + tuning.journal_mode);
+        }
+        if (!tuning.synchronous.empty()) {
+            exec("PRAGMA synchronous=" + tuning.synchronous);
+        }
+        exec("PRAGMA mmap_size=" + std::to_string(tuning.mmap_size));
+        // Negative values are KiB rather than pages
+        exec("PRAGMA cache_size=-" + std::to_string(tuning.cache_size_kib));
+
+        spdlog::info("SQLite tuning: journal_mode={}, synchronous={}, mmap_size={}, cache_size={}KiB",
+            tuning.journal_mode, tuning.synchronous, tuning.mmap_size, tuning.cache_size_kib);
+    }
+
+    void SqliteConnection::exec(const std::string& sql) {
+        char* error = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+            std::string message = error ? error : sqlite3_errmsg(db);
+            sqlite3_free(error);
+            throw std::runtime_error("SQLite error in \"" + sql + "\": " + message);
+        }
+    }
+
+    bool SqliteConnection::hasTable(const std::string& name) {
+        sqlite3_stmt* stmt = statement("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?");
+        sqlite3_bind_text(stmt, 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
+        bool found = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_reset(stmt);
+        return found;
+    }
+
+    sqlite3_stmt* SqliteConnection::statement(const std::string& sql) {
+        auto it = statements.find(sql);
+        if (it != statements.end()) {
+            sqlite3_reset(it->second);
+            sqlite3_clear_bindings(it->second);
+            return it->second;
+        }
+
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v3(db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+            fail("Failed to prepare \"" + sql + "\"");
+        }
+        statements.emplace(sql, stmt);
+        return stmt;
+    }
+
+    void SqliteConnection::fail(const std::string& what) const {
+        throw std::runtime_error(what + ": " + sqlite3_errmsg(db));
+    }
+}
@@ -0,0 +1,84 @@
+// StockTracker.DataService/src/SubscriptionRegistry.cpp
+#include "SubscriptionRegistry.h"
+#include <atomic>
+
+namespace StockTracker {
+
+    SubscriptionRegistry::SubscriptionRegistry()
+        : current(std::make_shared<const Set>())
+    {}
+
+    SubscriptionRegistry::Snapshot SubscriptionRegistry::snapshot() const {
+        return std::atomic_load_explicit(&current, std::memory_order_acquire);
+    }
+
+    void SubscriptionRegistry::publish(Snapshot next) {
+        std::atomic_store_explicit(&current, std::move(next), std::memory_order_release);
+    }
+
+    bool SubscriptionRegistry::contains(SymbolId symbol) const {
+        return snapshot()->count(symbol) != 0;
+    }
+
+    size_t SubscriptionRegistry::size() const {
+        return snapshot()->size();
+    }
+
+    bool SubscriptionRegistry::add(SymbolId symbol) {
+        std::lock_guard lock(write_mutex);
+        if (current->count(symbol) != 0) {
+            return false;
+        }
+
+        auto next = std::make_shared<Set>(*current);
+        next->insert(symbol);
+        publish(std::move(next));
+        return true;
+    }
+
+    bool SubscriptionRegistry::remove(SymbolId symbol) {
+        std::lock_guard lock(write_mutex);
+        if (current->count(symbol) == 0) {
+            return false;
+        }
+
+        auto next = std::make_shared<Set>(*current);
+        next->erase(symbol);
+        publish(std::move(next));
+        return true;
+    }
+
+    std::vector<SymbolId> SubscriptionRegistry::add(const std::vector<SymbolId>& symbols) {
+        std::vector<SymbolId> added;
+        std::lock_guard lock(write_mutex);
+
+        auto next = std::make_shared<Set>(*current);
+        for (const auto& symbol : symbols) {
+            if (next->insert(symbol).second) {
+                added.push_back(symbol);
+            }
+        }
+
+        if (!added.empty()) {
+            publish(std::move(next));
+        }
+        return added;
+    }
+
+    std::vector<SymbolId> SubscriptionRegistry::remove(const std::vector<SymbolId>& symbols) {
+        std::vector<SymbolId> removed;
+        std::lock_guard lock(write_mutex);
+
+        auto next = std::make_shared<Set>(*current);
+        for (const auto& symbol : symbols) {
+            if (next->erase(symbol) != 0) {
+                removed.push_back(symbol);
+            }
+        }
+
+        if (!removed.empty()) {
+            publish(std::move(next));
+        }
+        return removed;
+    }
+}
@@ -0,0 +1,98 @@
+// StockTracker.DataService/src/SubscriptionWriter.cpp
+#include "SubscriptionWriter.h"
+#include <spdlog/spdlog.h>
+
+namespace StockTracker {
+
+    SubscriptionWriter::SubscriptionWriter(DatabaseService& db_service, DatabaseMutex& database_mutex,
+        const SubscriptionWriterConfig& config)
+        : db_service(db_service)
+        , database_mutex(database_mutex)
+        , config(config)
+    {
+        writer_thread = std::thread(&SubscriptionWriter::writerLoop, this);
+    }
+
+    SubscriptionWriter::~SubscriptionWriter() {
+        stop();
+    }
+
+    void SubscriptionWriter::queue(const std::string& symbol, bool subscribed) {
+        {
+            std::lock_guard lock(mutex);
+            auto [it, inserted] = pending.try_emplace(symbol, subscribed);
+            if (!inserted) {
+                it->second = subscribed;
+                ++coalesced;
+            }
+        }
+        ++changes;
+        changed.notify_one();
+    }
+
+    void SubscriptionWriter::stop() {
+        {
+            std::lock_guard lock(mutex);
+            if (stopping) {
+                return;
+            }
+            stopping = true;
+        }
+        changed.notify_one();
+        if (writer_thread.joinable()) {
+            writer_thread.join();
+        }
+    }
+
+    SubscriptionWriterStats SubscriptionWriter::stats() const {
+        SubscriptionWriterStats s;
+        s.changes = changes.load();
+        s.coalesced = coalesced.load();
+        s.flushes = flushes.load();
+        return s;
+    }
+
+    void SubscriptionWriter::writerLoop() {
+        std::unordered_map<std::string, bool> batch;
+        while (true) {
+            bool done = false;
+            {
+                std::unique_lock lock(mutex);
+                changed.wait(lock, [this] { return stopping || !pending.empty(); });
+
+                // Let the rest of a burst arrive before writing
+                if (!stopping) {
+                    changed.wait_for(lock, config.flush_delay, [this] { return stopping; });
+                }
+                batch.swap(pending);
+                done = stopping;
+            }
+
+            if (!batch.empty()) {
+                write(batch);
+                batch.clear();
+            }
+            if (done) {
+                break;
+            }
+        }
+    }
+
+    void SubscriptionWriter::write(const std::unordered_map<std::string, bool>& batch) {
+        ++flushes;
+        std::lock_guard lock(database_mutex);
+        for (const auto& [symbol, subscribed] : batch) {
+            try {
+                if (subscribed) {
+                    db_service.saveSubscription(symbol);
+                }
+                else {
+                    db_service.removeSubscription(symbol);
+                }
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Failed to persist subscription change for {}: {}", symbol, e.what());
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// StockTracker.DataService/src/SymbolPartition.cpp
+#include "SymbolPartition.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace StockTracker {
+
+    SymbolPartition::SymbolPartition(const PartitionConfig& config)
+        : members(config.members)
+    {
+        if (members.empty()) {
+            return;
+        }
+
+        std::unordered_set<std::string> names;
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (!names.insert(members[i].name).second) {
+                throw std::runtime_error("Duplicate partition member: " + members[i].name);
+            }
+            if (members[i].name == config.self) {
+                self_index = i;
+            }
+        }
+        if (!names.count(config.self)) {
+            throw std::runtime_error("Partition self '" + config.self + "' is not a member");
+        }
+
+        const size_t points = std::max<size_t>(config.virtual_nodes, 1);
+        ring.reserve(members.size() * points);
+        for (size_t i = 0; i < members.size(); ++i) {
+            for (size_t point = 0; point < points; ++point) {
+                ring.emplace_back(hash(members[i].name + "#" + std::to_string(point)), i);
+            }
+        }
+        std::sort(ring.begin(), ring.end());
+    }
+
+    uint64_t SymbolPartition::hash(const std::string& key) {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : key) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        // FNV-1a alone clusters short, similar keys ("A#1", "A#2"); mix it
+        // so ring points and tickers spread over the whole range
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    const PartitionMember& SymbolPartition::owner(const std::string& symbol) const {
+        const uint64_t h = hash(symbol);
+        auto it = std::lower_bound(ring.begin(), ring.end(), std::make_pair(h, size_t{ 0 }));
+        if (it == ring.end()) {
+            it = ring.begin();  // Wrap around
+        }
+        return members[it->second];
+    }
+
+    bool SymbolPartition::owns(const std::string& symbol) const {
+        return !isPartitioned() || &owner(symbol) == &members[self_index];
+    }
+}
@@ -0,0 +1,46 @@
+// StockTracker.DataService/src/SymbolTable.cpp
+#include "SymbolTable.h"
+#include <mutex>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    SymbolId SymbolTable::intern(const std::string& symbol) {
+        {
+            std::shared_lock lock(mutex);
+            auto it = ids.find(symbol);
+            if (it != ids.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock(mutex);
+        auto [it, inserted] = ids.emplace(symbol, static_cast<SymbolId>(names.size()));
+        if (inserted) {
+            names.push_back(symbol);
+        }
+        return it->second;
+    }
+
+    std::optional<SymbolId> SymbolTable::find(const std::string& symbol) const {
+        std::shared_lock lock(mutex);
+        auto it = ids.find(symbol);
+        if (it == ids.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    const std::string& SymbolTable::name(SymbolId id) const {
+        std::shared_lock lock(mutex);
+        if (id >= names.size()) {
+            throw std::out_of_range("Unknown symbol id: " + std::to_string(id));
+        }
+        return names[id];
+    }
+
+    size_t SymbolTable::size() const {
+        std::shared_lock lock(mutex);
+        return names.size();
+    }
+}
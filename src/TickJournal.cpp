@@ -0,0 +1,344 @@
+// StockTracker.DataService/src/TickJournal.cpp
+#include "TickJournal.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace StockTracker {
+
+    namespace {
+        constexpr char Magic[8] = { 'S', 'T', 'K', 'J', 'R', 'N', 'L', '1' };
+        constexpr uint32_t Unassigned = std::numeric_limits<uint32_t>::max();
+        constexpr int64_t MicrosPerDay = 86400LL * 1000 * 1000;
+
+        int64_t toMicros(std::chrono::system_clock::time_point t) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count();
+        }
+
+        int64_t dayOf(int64_t us) {
+            return (us >= 0 ? us : us - MicrosPerDay + 1) / MicrosPerDay;
+        }
+
+        // Days since 1970-01-01 -> YYYYMMDD (Howard Hinnant's civil_from_days)
+        int64_t civilDate(int64_t days) {
+            days += 719468;
+            const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            const int64_t doe = days - era * 146097;
+            const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const int64_t mp = (5 * doy + 2) / 153;
+            const int64_t d = doy - (153 * mp + 2) / 5 + 1;
+            const int64_t m = mp < 10 ? mp + 3 : mp - 9;
+            const int64_t y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+            return y * 10000 + m * 100 + d;
+        }
+    }
+
+    TickJournal::TickJournal(SymbolTable& symbol_table, const TickJournalConfig& config)
+        : symbol_table(symbol_table)
+        , config(config)
+    {
+        std::filesystem::create_directories(config.directory);
+        loadSymbols();
+        loadSegments();
+
+        auto s = stats();
+        spdlog::info("Tick journal {}: {} segments, {} records, {} symbols",
+            config.directory, s.segments, s.records, symbol_ids.size());
+    }
+
+    TickJournal::~TickJournal() {
+        std::unique_lock lock(mutex);
+        if (!segments.empty()) {
+            try {
+                trim(*segments.back());
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Cannot trim tick journal segment: {}", e.what());
+            }
+        }
+    }
+
+    void TickJournal::loadSymbols() {
+        std::ifstream in(std::filesystem::path(config.directory) / "symbols.txt");
+        std::string name;
+        while (std::getline(in, name)) {
+            SymbolId id = symbol_table.intern(name);
+            if (id >= journal_ids.size()) {
+                journal_ids.resize(id + 1, Unassigned);
+            }
+            journal_ids[id] = static_cast<uint32_t>(symbol_ids.size());
+            symbol_ids.push_back(id);
+        }
+    }
+
+    uint32_t TickJournal::journalSymbol(SymbolId symbol) {
+        if (symbol < journal_ids.size() && journal_ids[symbol] != Unassigned) {
+            return journal_ids[symbol];
+        }
+
+        // New symbol: the dictionary line goes out before any record uses it
+        std::ofstream out(std::filesystem::path(config.directory) / "symbols.txt", std::ios::app);
+        out << symbol_table.name(symbol) << '\n';
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Cannot extend tick journal symbol file");
+        }
+
+        if (symbol >= journal_ids.size()) {
+            journal_ids.resize(symbol + 1, Unassigned);
+        }
+        journal_ids[symbol] = static_cast<uint32_t>(symbol_ids.size());
+        symbol_ids.push_back(symbol);
+        return journal_ids[symbol];
+    }
+
+    void TickJournal::loadSegments() {
+        for (const auto& entry : std::filesystem::directory_iterator(config.directory)) {
+            const auto name = entry.path().filename().string();
+            if (!entry.is_regular_file() || name.rfind("ticks-", 0) != 0 || entry.path().extension() != ".seg") {
+                continue;
+            }
+            try {
+                segments.push_back(openSegment(entry.path().string(), 0, 0, false));
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Skipping tick journal segment {}: {}", name, e.what());
+            }
+        }
+
+        std::sort(segments.begin(), segments.end(), [](const auto& a, const auto& b) {
+            return a->day != b->day ? a->day < b->day : a->part < b->part;
+        });
+        // Left untrimmed if the service stopped without closing the journal
+        for (size_t i = 0; i + 1 < segments.size(); ++i) {
+            trim(*segments[i]);
+        }
+        expireSegments(toMicros(std::chrono::system_clock::now()));
+    }
+
+    std::unique_ptr<TickJournal::Segment> TickJournal::openSegment(const std::string& path, int64_t day,
+        uint32_t part, bool create) {
+        const size_t records = std::max<size_t>(config.segment_bytes / sizeof(Record), 1);
+        const size_t growth = std::clamp<size_t>(config.segment_growth_bytes / sizeof(Record), 1, records);
+        auto segment = std::make_unique<Segment>();
+        segment->file = std::make_unique<MappedFile>(path, create ? sizeof(Header) + growth * sizeof(Record) : 0);
+        if (segment->file->size() < sizeof(Header)) {
+            throw std::runtime_error("truncated header");
+        }
+
+        Header& header = segment->header();
+        if (create) {
+            std::memcpy(header.magic, Magic, sizeof(Magic));
+            header.record_size = sizeof(Record);
+            header.part = part;
+            header.records = 0;
+            header.day = day;
+        }
+        else if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.record_size != sizeof(Record)) {
+            throw std::runtime_error("not a tick journal segment");
+        }
+
+        segment->day = header.day;
+        segment->part = header.part;
+        segment->mapped = (segment->file->size() - sizeof(Header)) / sizeof(Record);
+        segment->count = std::min<size_t>(header.records, segment->mapped);
+        segment->capacity = std::max(records, segment->mapped);
+
+        // Rebuild the index: one sequential pass over the mapped records
+        for (size_t i = 0; i < segment->count; ++i) {
+            indexRecord(*segment, i);
+        }
+        return segment;
+    }
+
+    void TickJournal::indexRecord(Segment& segment, size_t position) {
+        const Record& record = segment.records()[position];
+        const size_t block_records = std::max<size_t>(config.index_block_records, 1);
+        const uint32_t block = static_cast<uint32_t>(position / block_records);
+
+        if (block >= segment.blocks.size()) {
+            segment.blocks.push_back(Block{ record.timestamp_us, record.timestamp_us });
+        }
+        auto& range = segment.blocks[block];
+        range.min_us = std::min(range.min_us, record.timestamp_us);
+        range.max_us = std::max(range.max_us, record.timestamp_us);
+        segment.min_us = std::min(segment.min_us, record.timestamp_us);
+        segment.max_us = std::max(segment.max_us, record.timestamp_us);
+
+        if (record.symbol >= segment.blocks_by_symbol.size()) {
+            segment.blocks_by_symbol.resize(record.symbol + 1);
+        }
+        auto& blocks = segment.blocks_by_symbol[record.symbol];
+        if (blocks.empty() || blocks.back() != block) {
+            blocks.push_back(block);
+        }
+    }
+
+    TickJournal::Segment& TickJournal::segmentFor(int64_t day) {
+        // A tick that arrives after midnight for the previous day stays in
+        // the current segment; block time ranges keep scans correct
+        if (!segments.empty()) {
+            Segment& current = *segments.back();
+            if (day <= current.day && current.count < current.capacity) {
+                return current;
+            }
+        }
+
+        // The current segment is sealed from here on
+        if (!segments.empty()) {
+            trim(*segments.back());
+        }
+
+        uint32_t part = 0;
+        if (!segments.empty() && segments.back()->day >= day) {
+            day = segments.back()->day;
+            part = segments.back()->part + 1;
+        }
+
+        auto path = std::filesystem::path(config.directory) /
+            fmt::format("ticks-{}-{}.seg", civilDate(day), part);
+        segments.push_back(openSegment(path.string(), day, part, true));
+        return *segments.back();
+    }
+
+    void TickJournal::expireSegments(int64_t now_us) {
+        if (config.retention.count() <= 0) {
+            return;
+        }
+
+        const int64_t cutoff = now_us - std::chrono::duration_cast<std::chrono::microseconds>(config.retention).count();
+        // Never the segment taking appends
+        while (segments.size() > 1 && segments.front()->max_us < cutoff) {
+            const std::string path = segments.front()->file->path();
+            segments.erase(segments.begin());
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            spdlog::info("Removed expired tick journal segment {}", path);
+        }
+    }
+
+    void TickJournal::commit(Segment& segment, size_t first) {
+        // Records first, then the count that makes them visible on reopen
+        if (config.sync_each_batch) {
+            segment.file->flush(sizeof(Header) + first * sizeof(Record), (segment.count - first) * sizeof(Record));
+        }
+        segment.header().records = segment.count;
+        if (config.sync_each_batch) {
+            segment.file->flush(0, sizeof(Header));
+        }
+    }
+
+    void TickJournal::grow(Segment& segment) {
+        const size_t growth = std::max<size_t>(config.segment_growth_bytes / sizeof(Record), 1);
+        const size_t records = std::min(segment.capacity, segment.mapped + growth);
+        segment.file->resize(sizeof(Header) + records * sizeof(Record));
+        segment.mapped = records;
+    }
+
+    void TickJournal::trim(Segment& segment) {
+        if (segment.mapped > segment.count) {
+            segment.file->resize(sizeof(Header) + segment.count * sizeof(Record));
+            segment.mapped = segment.count;
+        }
+    }
+
+    size_t TickJournal::append(const std::vector<Tick>& ticks) {
+        std::unique_lock lock(mutex);
+
+        const size_t segments_before = segments.size();
+        Segment* current = nullptr;
+        size_t first = 0;  // First record this batch wrote to `current`
+        size_t appended = 0;
+        for (const auto& tick : ticks) {
+            const int64_t us = toMicros(tick.timestamp);
+            Segment& segment = segmentFor(dayOf(us));
+            if (&segment != current) {
+                if (current) {
+                    commit(*current, first);
+                }
+                current = &segment;
+                first = segment.count;
+            }
+
+            if (segment.count == segment.mapped) {
+                grow(segment);  // Remaps: records() moves
+            }
+            Record& record = segment.records()[segment.count];
+            record.timestamp_us = us;
+            record.price = tick.price;
+            record.symbol = journalSymbol(tick.symbol);
+            record.reserved = 0;
+            indexRecord(segment, segment.count);
+            ++segment.count;
+            ++appended;
+        }
+
+        if (current) {
+            commit(*current, first);
+        }
+        if (segments.size() != segments_before) {
+            expireSegments(toMicros(std::chrono::system_clock::now()));
+        }
+        return appended;
+    }
+
+    std::vector<PriceHistoryCache::Point> TickJournal::history(SymbolId symbol, TimePoint from, TimePoint to) {
+        std::vector<PriceHistoryCache::Point> points;
+        std::shared_lock lock(mutex);
+        if (symbol >= journal_ids.size() || journal_ids[symbol] == Unassigned) {
+            return points;
+        }
+
+        const uint32_t journal_symbol = journal_ids[symbol];
+        const int64_t from_us = from == TimePoint::min() ? INT64_MIN : toMicros(from);
+        const int64_t to_us = to == TimePoint::max() ? INT64_MAX : toMicros(to);
+        const size_t block_records = std::max<size_t>(config.index_block_records, 1);
+
+        for (const auto& segment : segments) {
+            if (segment->count == 0 || segment->max_us < from_us || segment->min_us >= to_us ||
+                journal_symbol >= segment->blocks_by_symbol.size()) {
+                continue;
+            }
+
+            const Record* records = segment->records();
+            for (uint32_t block : segment->blocks_by_symbol[journal_symbol]) {
+                const auto& range = segment->blocks[block];
+                if (range.max_us < from_us || range.min_us >= to_us) {
+                    continue;
+                }
+                const size_t begin = static_cast<size_t>(block) * block_records;
+                const size_t end = std::min(begin + block_records, segment->count);
+                for (size_t i = begin; i < end; ++i) {
+                    const Record& record = records[i];
+                    if (record.symbol == journal_symbol && record.timestamp_us >= from_us && record.timestamp_us < to_us) {
+                        points.push_back(PriceHistoryCache::Point{
+                            TimePoint(std::chrono::microseconds(record.timestamp_us)), record.price });
+                    }
+                }
+            }
+        }
+
+        // Records are in arrival order; a late tick can land after a newer one
+        auto older = [](const auto& a, const auto& b) { return a.timestamp < b.timestamp; };
+        if (!std::is_sorted(points.begin(), points.end(), older)) {
+            std::stable_sort(points.begin(), points.end(), older);
+        }
+        return points;
+    }
+
+    TickJournalStats TickJournal::stats() const {
+        std::shared_lock lock(mutex);
+        TickJournalStats s;
+        s.segments = segments.size();
+        for (const auto& segment : segments) {
+            s.records += segment->count;
+            s.bytes += segment->file->size();
+        }
+        return s;
+    }
+}
@@ -0,0 +1,120 @@
+// StockTracker.DataService/src/TickScheduler.cpp
+#include "TickScheduler.h"
+#include <cmath>
+
+namespace StockTracker {
+
+    TickScheduler::TickScheduler(const TickSchedulerConfig& config)
+        : config(config)
+    {}
+
+    std::chrono::milliseconds TickScheduler::intervalFor(const std::string& symbol) const {
+        auto it = config.symbol_intervals.find(symbol);
+        return it != config.symbol_intervals.end() ? it->second : config.default_interval;
+    }
+
+    void TickScheduler::schedule(SymbolId symbol, std::chrono::milliseconds interval) {
+        if (interval <= std::chrono::milliseconds::zero()) {
+            interval = std::chrono::milliseconds(1);
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            uint64_t generation = ++next_generation;
+            if (symbol >= slots.size()) {
+                slots.resize(symbol + 1);
+            }
+            slots[symbol] = Slot{ interval, generation };
+            heap.push(Entry{ Clock::now() + phaseOffset(interval), generation, symbol });
+        }
+        changed.notify_one();
+    }
+
+    void TickScheduler::cancel(SymbolId symbol) {
+        // The heap entry is discarded lazily when it reaches the top
+        std::lock_guard lock(mutex);
+        if (symbol < slots.size()) {
+            slots[symbol].generation = 0;
+        }
+    }
+
+    // Caller holds mutex
+    bool TickScheduler::isCurrent(const Entry& entry) const {
+        return entry.symbol < slots.size() && slots[entry.symbol].generation == entry.generation;
+    }
+
+    // Golden-ratio sequence: each new symbol lands in the largest gap left
+    // by the previous ones, whatever the final count turns out to be.
+    TickScheduler::Clock::duration TickScheduler::phaseOffset(Clock::duration interval) {
+        constexpr double golden = 0.6180339887498949;
+        double fraction = std::fmod(static_cast<double>(spread_index++) * golden, 1.0);
+        return std::chrono::duration_cast<Clock::duration>(interval * fraction);
+    }
+
+    bool TickScheduler::waitDue(std::vector<SymbolId>& due, std::optional<Clock::time_point> wake_by) {
+        std::unique_lock lock(mutex);
+
+        while (!stopped) {
+            auto now = Clock::now();
+            if (wake_by && *wake_by <= now) {
+                return true;
+            }
+
+            // Drop entries for cancelled or rescheduled symbols
+            while (!heap.empty() && !isCurrent(heap.top())) {
+                heap.pop();
+            }
+
+            if (heap.empty()) {
+                if (wake_by) {
+                    changed.wait_until(lock, *wake_by);
+                }
+                else {
+                    changed.wait(lock);
+                }
+                continue;
+            }
+
+            if (heap.top().deadline > now) {
+                auto until = heap.top().deadline;
+                if (wake_by && *wake_by < until) {
+                    until = *wake_by;
+                }
+                changed.wait_until(lock, until);
+                continue;
+            }
+
+            // Pop everything that is due and schedule its next deadline
+            while (!heap.empty() && heap.top().deadline <= now) {
+                Entry entry = heap.top();
+                heap.pop();
+
+                if (!isCurrent(entry)) {
+                    continue;
+                }
+
+                const auto interval = slots[entry.symbol].interval;
+                entry.deadline += interval;
+                if (entry.deadline <= now) {
+                    // Fell behind by more than one interval: skip the missed
+                    // ticks but stay on the original phase
+                    auto missed = (now - entry.deadline) / interval + 1;
+                    entry.deadline += interval * missed;
+                }
+
+                due.push_back(entry.symbol);
+                heap.push(entry);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void TickScheduler::stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopped = true;
+        }
+        changed.notify_all();
+    }
+}
@@ -1,22 +1,28 @@
 #include "DataService.h"
+#include "Logging.h"
 #include <spdlog/spdlog.h>
 #include <iostream>
 
 int main() {
-    try {
-        // Set up logging
-        spdlog::set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
+    StockTracker::DataServiceConfig config;
+
+    // Set up logging
+    StockTracker::configureLogging(config.logging);
 
+    int status = 0;
+    try {
         std::cout << "Starting Stock Data Service...\n";
 
         // Create and run service
-        StockTracker::DataService service;
+        StockTracker::DataService service(config);
         service.run();
-
-        return 0;
     }
     catch (const std::exception& e) {
         spdlog::error("Fatal error: {}", e.what());
-        return 1;
+        status = 1;
     }
+
+    // Flush whatever the async logger still has queued
+    StockTracker::shutdownLogging();
+    return status;
 }
\ No newline at end of file